@@ -0,0 +1,29 @@
+﻿#include "Benchmark.h"
+#include "Data/Mesh.h"
+
+#include <boost/filesystem.hpp>
+
+using namespace Tristeon;
+
+/**
+ * Mesh::load of the primitives in bin/Files, including the assimp import and the conversion into submeshes
+ */
+TRISTEON_BENCHMARK(meshLoad)
+{
+	for (const char* path : { "Files/Models/Primitives/Cube.obj", "Files/Models/Primitives/Sphere.obj" })
+	{
+		std::string const name = std::string("Mesh::load/") + path;
+		if (!boost::filesystem::exists(path))
+		{
+			runner.skip(name, "the file doesn't exist in the working directory");
+			continue;
+		}
+
+		runner.measure(name, [&]
+		{
+			Data::Mesh mesh;
+			mesh.load(path);
+			Bench::doNotOptimize(mesh.submeshes);
+		});
+	}
+}
\ No newline at end of file
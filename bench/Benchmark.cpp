@@ -0,0 +1,62 @@
+﻿#include "Benchmark.h"
+#include <algorithm>
+#include <iostream>
+
+namespace Tristeon
+{
+	namespace Bench
+	{
+		const void* volatile sink = nullptr;
+
+		std::vector<std::pair<std::string, BenchmarkFunction>>& getBenchmarks()
+		{
+			static std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks;
+			return benchmarks;
+		}
+
+		void Runner::skip(std::string const& name, std::string const& reason)
+		{
+			if (!matches(name))
+				return;
+
+			Result result;
+			result.name = name;
+			result.skipped = reason;
+			results.push_back(result);
+			std::cerr << name << ": skipped, " << reason << std::endl;
+		}
+
+		void Runner::run(std::string const& name, std::function<void(uint64_t)> const& batch)
+		{
+			using clock = std::chrono::steady_clock;
+			auto const time = [&](uint64_t iterations)
+			{
+				clock::time_point const start = clock::now();
+				batch(iterations);
+				return std::chrono::duration<double>(clock::now() - start).count();
+			};
+
+			//Grow the batch until a sample takes long enough to be measured reliably, this doubles as the warmup
+			double const sampleTime = minTime / sampleCount;
+			uint64_t iterations = 1;
+			double elapsed = time(iterations);
+			while (elapsed < sampleTime)
+			{
+				double const factor = elapsed > 0 ? sampleTime / elapsed * 1.2 : 10;
+				iterations = std::max(iterations + 1, uint64_t(double(iterations) * std::min(factor, 10.0)));
+				elapsed = time(iterations);
+			}
+
+			Result result;
+			result.name = name;
+			result.iterations = iterations;
+			for (size_t i = 0; i < sampleCount; i++)
+				result.samples.push_back(time(iterations) * 1e9 / double(iterations));
+			results.push_back(result);
+
+			std::vector<double> sorted = result.samples;
+			std::sort(sorted.begin(), sorted.end());
+			std::cerr << name << ": " << sorted[sorted.size() / 2] << " ns/op (" << iterations << " ops/sample)" << std::endl;
+		}
+	}
+}
\ No newline at end of file
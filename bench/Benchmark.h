@@ -0,0 +1,117 @@
+﻿#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Tristeon
+{
+	namespace Bench
+	{
+		/**
+		 * The measurements of a single benchmark, in nanoseconds per operation
+		 */
+		struct Result
+		{
+			std::string name;
+			/**
+			 * The amount of operations per sample
+			 */
+			uint64_t iterations = 0;
+			std::vector<double> samples;
+			/**
+			 * Set if the benchmark couldn't run, e.g. because an asset is missing
+			 */
+			std::string skipped;
+		};
+
+		/**
+		 * Runner is passed to every benchmark function, benchmarks call measure() once per variant they want to measure.
+		 * Every variant is first calibrated so that a sample takes roughly minTime / sampleCount, then sampleCount samples are taken.
+		 */
+		class Runner final
+		{
+		public:
+			Runner(std::string filter, double minTime, size_t sampleCount) : filter(std::move(filter)), minTime(minTime), sampleCount(sampleCount) { }
+
+			/**
+			 * Measures the given function, which performs a single operation. Does nothing if the name doesn't match the filter.
+			 */
+			template <typename F>
+			void measure(std::string const& name, F function);
+
+			/**
+			 * Records that the given benchmark couldn't run
+			 */
+			void skip(std::string const& name, std::string const& reason);
+
+			/**
+			 * Returns true if a benchmark with the given name would be measured, so that expensive setups can be skipped
+			 */
+			bool matches(std::string const& name) const { return name.find(filter) != std::string::npos; }
+
+			std::vector<Result> const& getResults() const { return results; }
+		private:
+			/**
+			 * Calibrates and samples batch, which performs the given amount of operations
+			 */
+			void run(std::string const& name, std::function<void(uint64_t)> const& batch);
+
+			std::string filter;
+			double minTime;
+			size_t sampleCount;
+			std::vector<Result> results;
+		};
+
+		template <typename F>
+		void Runner::measure(std::string const& name, F function)
+		{
+			if (!matches(name))
+				return;
+			//The operation is inlined into the batch loop, only the batch itself is called through std::function
+			run(name, [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; i++)
+					function();
+			});
+		}
+
+		/**
+		 * Written by doNotOptimize, a volatile store of the address forces the value to exist in memory
+		 */
+		extern const void* volatile sink;
+
+		/**
+		 * Keeps the compiler from optimizing the computation of the given value away
+		 */
+		template <typename T>
+		void doNotOptimize(T const& value)
+		{
+			sink = static_cast<const void*>(&value);
+		}
+
+		typedef void (*BenchmarkFunction)(Runner&);
+
+		/**
+		 * Returns every benchmark that has been registered with TRISTEON_BENCHMARK
+		 */
+		std::vector<std::pair<std::string, BenchmarkFunction>>& getBenchmarks();
+
+		/**
+		 * Registers a benchmark function during static initialization
+		 */
+		struct Registrar
+		{
+			Registrar(const char* name, BenchmarkFunction function) { getBenchmarks().emplace_back(name, function); }
+		};
+	}
+}
+
+/**
+ * Defines and registers a benchmark function, which receives the Runner as runner
+ */
+#define TRISTEON_BENCHMARK(name) \
+	static void name(::Tristeon::Bench::Runner& runner); \
+	static ::Tristeon::Bench::Registrar name##Registrar(#name, &name); \
+	static void name(::Tristeon::Bench::Runner& runner)
@@ -0,0 +1,193 @@
+﻿/*
+ tristeon_bench runs the microbenchmarks of the engine's hot paths and writes the results as json.
+
+ USAGE
+ * tristeon_bench [--filter=NAME] [--min-time=SECONDS] [--samples=COUNT] [--output=FILE] [--baseline=FILE] [--list]
+ * Benchmarks whose name doesn't contain the filter are skipped.
+ * Results are written to stdout, or to the output file. Progress is written to stderr.
+ * If a baseline (the output of an earlier run) is given, the change of every median is written to stderr.
+ * Assets are loaded relative to the working directory, run the benchmarks from bin/ to include them.
+*/
+
+#include "Benchmark.h"
+#include "Editor/json.hpp"
+#include "Math/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+using namespace Tristeon::Bench;
+
+namespace
+{
+	nlohmann::json toJson(Result const& result)
+	{
+		nlohmann::json json;
+		json["name"] = result.name;
+		if (!result.skipped.empty())
+		{
+			json["skipped"] = result.skipped;
+			return json;
+		}
+
+		std::vector<double> sorted = result.samples;
+		std::sort(sorted.begin(), sorted.end());
+		size_t const count = sorted.size();
+
+		double mean = 0;
+		for (double sample : sorted)
+			mean += sample;
+		mean /= count;
+		double variance = 0;
+		for (double sample : sorted)
+			variance += (sample - mean) * (sample - mean);
+
+		json["iterations"] = result.iterations;
+		json["samples"] = count;
+		json["min_ns"] = sorted.front();
+		json["median_ns"] = count % 2 == 1 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+		json["mean_ns"] = mean;
+		json["stddev_ns"] = count > 1 ? std::sqrt(variance / (count - 1)) : 0.0;
+		return json;
+	}
+
+	nlohmann::json getContext()
+	{
+		nlohmann::json context;
+		char date[32];
+		std::time_t const now = std::time(nullptr);
+		std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+		context["date"] = date;
+#ifdef NDEBUG
+		context["build"] = "release";
+#else
+		context["build"] = "debug";
+#endif
+#if defined(_MSC_VER)
+		context["compiler"] = "msvc " + std::to_string(_MSC_VER);
+#elif defined(__clang__)
+		context["compiler"] = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+		context["compiler"] = std::string("gcc ") + __VERSION__;
+#endif
+#if defined(TRISTEON_SIMD_AVX2)
+		context["simd"] = "avx2";
+#elif defined(TRISTEON_SIMD_SSE2)
+		context["simd"] = "sse2";
+#else
+		context["simd"] = "scalar";
+#endif
+#ifdef TRISTEON_PROFILER
+		context["profiler"] = true;
+#else
+		context["profiler"] = false;
+#endif
+		return context;
+	}
+
+	void compare(nlohmann::json const& results, std::string const& baselinePath)
+	{
+		std::ifstream stream(baselinePath);
+		if (!stream.is_open())
+		{
+			std::cerr << "Couldn't open baseline " << baselinePath << std::endl;
+			return;
+		}
+		nlohmann::json baseline;
+		stream >> baseline;
+
+		std::map<std::string, double> medians;
+		for (nlohmann::json const& benchmark : baseline["benchmarks"])
+		{
+			if (benchmark.find("median_ns") != benchmark.end())
+				medians[benchmark["name"].get<std::string>()] = benchmark["median_ns"];
+		}
+
+		std::cerr << std::endl << "Compared to " << baselinePath << ":" << std::endl;
+		for (nlohmann::json const& benchmark : results["benchmarks"])
+		{
+			std::string const name = benchmark["name"];
+			auto const old = medians.find(name);
+			if (old == medians.end() || benchmark.find("median_ns") == benchmark.end())
+				continue;
+
+			double const median = benchmark["median_ns"];
+			double const change = (median - old->second) / old->second * 100.0;
+			std::cerr << name << ": " << old->second << " -> " << median << " ns/op (" << (change >= 0 ? "+" : "") << change << "%)" << std::endl;
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string filter;
+	std::string outputPath;
+	std::string baselinePath;
+	double minTime = 0.5;
+	size_t sampleCount = 10;
+	bool list = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string const argument = argv[i];
+		size_t const separator = argument.find('=');
+		std::string const name = argument.substr(0, separator);
+		std::string const value = separator == std::string::npos ? "" : argument.substr(separator + 1);
+
+		if (name == "--filter")
+			filter = value;
+		else if (name == "--min-time")
+			minTime = std::max(std::stod(value), 0.001);
+		else if (name == "--samples")
+			sampleCount = size_t(std::max(std::stoi(value), 1));
+		else if (name == "--output")
+			outputPath = value;
+		else if (name == "--baseline")
+			baselinePath = value;
+		else if (name == "--list")
+			list = true;
+		else
+		{
+			std::cerr << "Unknown argument " << argument << std::endl;
+			return 1;
+		}
+	}
+
+	if (list)
+	{
+		for (auto const& benchmark : getBenchmarks())
+			std::cout << benchmark.first << std::endl;
+		return 0;
+	}
+
+	Runner runner(filter, minTime, sampleCount);
+	for (auto const& benchmark : getBenchmarks())
+		benchmark.second(runner);
+
+	nlohmann::json output;
+	output["context"] = getContext();
+	output["benchmarks"] = nlohmann::json::array();
+	for (Result const& result : runner.getResults())
+		output["benchmarks"].push_back(toJson(result));
+
+	if (outputPath.empty())
+		std::cout << output.dump(4) << std::endl;
+	else
+	{
+		std::ofstream stream(outputPath);
+		if (!stream.is_open())
+		{
+			std::cerr << "Couldn't write to " << outputPath << std::endl;
+			return 1;
+		}
+		stream << output.dump(4) << std::endl;
+	}
+
+	if (!baselinePath.empty())
+		compare(output, baselinePath);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+﻿#include "Benchmark.h"
+#include "Core/Rendering/Material.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+using namespace Tristeon;
+using namespace Core::Rendering;
+
+namespace
+{
+	/**
+	 * Exposes the properties of Material, so that they can be filled without a shader file
+	 */
+	class BenchMaterial final : public Material
+	{
+	public:
+		using Material::floats;
+		using Material::colors;
+		using Material::vectors;
+	};
+
+	ShaderProperty makeProperty(std::string name, DataType type, size_t size)
+	{
+		ShaderProperty property;
+		property.name = name;
+		property.valueType = type;
+		property.shaderStage = Fragment;
+		property.size = size;
+		return property;
+	}
+}
+
+/**
+ * Material::packProperty, which writes the material properties into uniform buffer memory every frame
+ */
+TRISTEON_BENCHMARK(materialPacking)
+{
+	BenchMaterial material;
+	material.floats["Roughness"] = 0.5f;
+	material.colors["Albedo"] = Misc::Color(1, 0.5f, 0.25f, 1);
+	material.vectors["Offset"] = Math::Vector3(1, 2, 3);
+
+	ShaderProperty light = makeProperty("Light", DT_Struct, sizeof(glm::vec4) + sizeof(glm::vec3) + sizeof(float));
+	light.children.push_back(makeProperty("color", DT_Color, sizeof(glm::vec4)));
+	light.children.push_back(makeProperty("direction", DT_Vector3, sizeof(glm::vec3)));
+	light.children.push_back(makeProperty("intensity", DT_Float, sizeof(float)));
+	material.colors["Light.color"] = Misc::Color(1, 1, 1, 1);
+	material.vectors["Light.direction"] = Math::Vector3(0, -1, 0);
+	material.floats["Light.intensity"] = 2;
+
+	std::vector<ShaderProperty> const properties =
+	{
+		makeProperty("Roughness", DT_Float, sizeof(float)),
+		makeProperty("Albedo", DT_Color, sizeof(glm::vec4)),
+		makeProperty("Offset", DT_Vector3, sizeof(glm::vec3)),
+		light
+	};
+
+	uint8_t memory[64];
+	for (ShaderProperty const& property : properties)
+	{
+		runner.measure("Material::packProperty/" + property.name, [&]
+		{
+			material.packProperty(property, memory);
+			Bench::doNotOptimize(memory);
+		});
+	}
+}
\ No newline at end of file
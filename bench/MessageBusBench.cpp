@@ -0,0 +1,29 @@
+﻿#include "Benchmark.h"
+#include "Core/MessageBus.h"
+
+#include <vector>
+
+using namespace Tristeon;
+
+/**
+ * sendMessage to a type with the given amount of subscribers, every subscriber does a trivial amount of work
+ */
+TRISTEON_BENCHMARK(sendMessage)
+{
+	for (size_t subscriberCount : { 0, 1, 16, 256 })
+	{
+		std::vector<Core::MessageBus::Subscription> subscriptions;
+		uint64_t received = 0;
+		for (size_t i = 0; i < subscriberCount; i++)
+			subscriptions.push_back(Core::MessageBus::subscribeToMessage(Core::MT_SHARE_DATA, [&](Core::Message const&) { received++; }));
+
+		runner.measure("MessageBus::sendMessage/subscribers=" + std::to_string(subscriberCount), [&]
+		{
+			Core::MessageBus::sendMessage(Core::MT_SHARE_DATA);
+		});
+		Bench::doNotOptimize(received);
+
+		for (Core::MessageBus::Subscription const& subscription : subscriptions)
+			Core::MessageBus::unsubscribeFromMessage(subscription);
+	}
+}
\ No newline at end of file
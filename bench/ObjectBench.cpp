@@ -0,0 +1,45 @@
+﻿#include "Benchmark.h"
+#include "Core/TObject.h"
+#include "Misc/StringUtils.h"
+
+using namespace Tristeon;
+
+namespace
+{
+	/**
+	 * The smallest possible TObject, so that only the construction of TObject itself is measured
+	 */
+	class EmptyObject final : public Core::TObject
+	{
+	public:
+		nlohmann::json serialize() override { return nlohmann::json(); }
+		void deserialize(nlohmann::json /*json*/) override { }
+	};
+}
+
+/**
+ * Generating random strings, as was done for every instanceID before they became integers
+ */
+TRISTEON_BENCHMARK(generateRandom)
+{
+	for (int length : { 8, 16, 64 })
+	{
+		runner.measure("StringUtils::generateRandom/length=" + std::to_string(length), [&]
+		{
+			std::string const random = StringUtils::generateRandom(length);
+			Bench::doNotOptimize(random);
+		});
+	}
+}
+
+/**
+ * Constructing and destroying a TObject, which includes generating its instanceID
+ */
+TRISTEON_BENCHMARK(objectConstruction)
+{
+	runner.measure("TObject::TObject", []
+	{
+		EmptyObject object;
+		Bench::doNotOptimize(object);
+	});
+}
\ No newline at end of file
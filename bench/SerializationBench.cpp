@@ -0,0 +1,75 @@
+﻿#include "Benchmark.h"
+#include "Core/GameObject.h"
+#include "Scenes/Scene.h"
+#include "Editor/JsonSerializer.h"
+
+#include <boost/filesystem.hpp>
+#include <memory>
+
+using namespace Tristeon;
+
+/**
+ * Serializing a GameObject to json and deserializing it again
+ */
+TRISTEON_BENCHMARK(gameObjectSerialization)
+{
+	Core::GameObject gameObject;
+	gameObject.name = "Benchmark";
+	gameObject.transform.get()->localPosition = Math::Vector3(1, 2, 3);
+
+	runner.measure("GameObject::serialize", [&]
+	{
+		nlohmann::json const json = gameObject.serialize();
+		Bench::doNotOptimize(json);
+	});
+
+	nlohmann::json const json = gameObject.serialize();
+	runner.measure("GameObject::deserialize", [&]
+	{
+		gameObject.deserialize(json);
+	});
+}
+
+/**
+ * Deserializing a scene of bare GameObjects into a new scene, and the scene in bin/Assets if it can be found.
+ * The destruction of the scene is part of the measurement.
+ */
+TRISTEON_BENCHMARK(sceneDeserialization)
+{
+	for (size_t count : { 16, 256, 4096 })
+	{
+		std::string const name = "Scene::deserialize/gameObjects=" + std::to_string(count);
+		if (!runner.matches(name))
+			continue;
+
+		nlohmann::json json;
+		{
+			Scenes::Scene scene;
+			scene.name = "Benchmark";
+			for (size_t i = 0; i < count; i++)
+				scene.addGameObject(std::make_unique<Core::GameObject>());
+			json = scene.serialize();
+		}
+
+		runner.measure(name, [&]
+		{
+			Scenes::Scene scene;
+			scene.deserialize(json);
+			Bench::doNotOptimize(scene);
+		});
+	}
+
+	std::string const path = "Assets/RenderTest.scene";
+	if (!boost::filesystem::exists(path))
+	{
+		runner.skip("Scene::deserialize/" + path, "the file doesn't exist in the working directory");
+		return;
+	}
+	nlohmann::json const json = JsonSerializer::load(path);
+	runner.measure("Scene::deserialize/" + path, [&]
+	{
+		Scenes::Scene scene;
+		scene.deserialize(json);
+		Bench::doNotOptimize(scene);
+	});
+}
\ No newline at end of file
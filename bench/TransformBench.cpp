@@ -0,0 +1,53 @@
+﻿#include "Benchmark.h"
+#include "Core/Transform.h"
+
+#include <memory>
+#include <vector>
+
+using namespace Tristeon;
+
+/**
+ * getTransformationMatrix of the leaf of a chain of transforms.
+ * Cached reads the matrix without changes, dirty moves the root before every read so the whole chain is recalculated.
+ */
+TRISTEON_BENCHMARK(transformationMatrix)
+{
+	for (size_t depth : { 1, 4, 16, 64 })
+	{
+		std::string const name = "Transform::getTransformationMatrix/depth=" + std::to_string(depth);
+		if (!runner.matches(name))
+			continue;
+
+		std::vector<std::unique_ptr<Core::Transform>> chain;
+		for (size_t i = 0; i < depth; i++)
+		{
+			chain.push_back(std::make_unique<Core::Transform>());
+			chain.back()->localPosition = Math::Vector3(1, 0, 0);
+			chain.back()->localRotation = Math::Quaternion(0, 0.3826834f, 0, 0.9238795f);
+			if (i > 0)
+				chain.back()->setParent(chain[i - 1].get(), false);
+		}
+
+		Core::Transform* root = chain.front().get();
+		Core::Transform* leaf = chain.back().get();
+
+		runner.measure(name + "/cached", [&]
+		{
+			glm::mat4 const matrix = leaf->getTransformationMatrix();
+			Bench::doNotOptimize(matrix);
+		});
+
+		float x = 0;
+		runner.measure(name + "/dirty", [&]
+		{
+			x += 1;
+			root->localPosition = Math::Vector3(x, 0, 0);
+			glm::mat4 const matrix = leaf->getTransformationMatrix();
+			Bench::doNotOptimize(matrix);
+		});
+
+		//Children are destroyed first
+		while (!chain.empty())
+			chain.pop_back();
+	}
+}
\ No newline at end of file
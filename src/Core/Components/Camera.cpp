@@ -61,7 +61,7 @@ namespace Tristeon
 					par = getViewMatrix(t->getParent());
 
 				//Get transformation
-				glm::mat4 const tran = translate(glm::mat4(1.0f), Vec_Convert3(t->position.get()));
+				glm::mat4 const tran = translate(glm::mat4(1.0f), glm::vec3(t->position.get()));
 				glm::mat4 const rot = glm::mat4(t->rotation.get().getGLMQuat());
 
 				//TODO: Parent calculation untested
@@ -8,12 +8,38 @@ namespace Tristeon
 	{
 		namespace Components
 		{
+			Component::Component() : handle(HandleTable<Component>::create(this))
+			{
+			}
+
 			Component::~Component()
 			{
+				HandleTable<Component>::destroy(handle);
 				if (registered)
 					MessageBus::sendMessage({ MT_SCRIPTINGCOMPONENT_DEREGISTER, this });
 			}
 
+			void* Component::operator new(std::size_t size)
+			{
+				return ComponentPool::allocateUnpooled(size);
+			}
+
+			void* Component::operator new(std::size_t size, ComponentPool& pool)
+			{
+				Misc::Console::t_assert(size <= pool.getObjectSize(), "Component is too large for the given ComponentPool!");
+				return pool.allocate();
+			}
+
+			void Component::operator delete(void* ptr)
+			{
+				ComponentPool::deallocate(ptr);
+			}
+
+			void Component::operator delete(void* ptr, ComponentPool& pool)
+			{
+				ComponentPool::deallocate(ptr);
+			}
+
 			Component::property__tmp_type_transform Component::get_transform()
 			{
 				return _gameObject->transform.get();
@@ -1,6 +1,10 @@
 ﻿#pragma once
 #include "Core/TObject.h"
+#include "Core/Handle.h"
 #include "Misc/Property.h"
+#include "Editor/TypeRegister.h"
+#include "ComponentPool.h"
+#include "ComponentTraits.h"
 
 namespace Tristeon
 {
@@ -15,16 +19,46 @@ namespace Tristeon
 			/**
 			 * Component is the base class of all components in the engine. A component is a piece of behavior that can be added to a gameobject.
 			 */
+			class ComponentManager;
+
 			class Component : public TObject
 			{
 				friend GameObject;
+				friend ComponentManager;
+				template <typename, typename> friend struct ::InstanceAllocator;
 
 			public:
+				Component();
 				/**
 				 * Deregisters itself from engine callbacks
 				 */
 				~Component();
 
+				Component(Component const&) = delete;
+				Component& operator=(Component const&) = delete;
+
+				/**
+				 * Returns a handle to this component. The handle resolves to nullptr once the component is destroyed.
+				 */
+				Handle<Component> getHandle() const { return handle; }
+
+				/**
+				 * Allocates a component that isn't stored in a type pool. Used when the concrete type is unknown at the call site.
+				 */
+				static void* operator new(std::size_t size);
+				/**
+				 * Allocates a component in the given type pool. Used by GameObject::addComponent and the TypeRegister.
+				 */
+				static void* operator new(std::size_t size, ComponentPool& pool);
+				/**
+				 * Returns the component's memory to the pool it was allocated from
+				 */
+				static void operator delete(void* ptr);
+				/**
+				 * Called if the constructor of a pooled component throws
+				 */
+				static void operator delete(void* ptr, ComponentPool& pool);
+
 				/**
 				* The gameobject that this component is attached to
 				*/
@@ -58,6 +92,12 @@ namespace Tristeon
 				 * LateUpdate gets called after all the other update calls
 				 */
 				virtual void lateUpdate() {}
+
+				/**
+				 * The data this type accesses during update and fixedUpdate (ComponentAccess flags).
+				 * Derived types can redeclare this to allow their instances to be updated in parallel.
+				 */
+				static const uint8_t componentAccess = CA_SHARED;
 			private:
 				/**
 				 * Stores the gameobject it's attached to. Only GameObject can call this function
@@ -68,9 +108,44 @@ namespace Tristeon
 				 * The gameobject this component is attached to
 				 */
 				GameObject* _gameObject = nullptr;
+				/**
+				 * The ComponentTraits type ID of the concrete type. Set when the component is created through a typed path.
+				 */
+				uint32_t typeID = ComponentTraits::invalidTypeID;
+				/**
+				 * The location of this component in the ComponentManager, used for constant time deregistration.
+				 * managerBucket is ComponentManager::pendingBucket while the registration is deferred.
+				 */
+				size_t managerBucket = SIZE_MAX;
+				size_t managerRow = 0;
+
+				Handle<Component> handle;
 			protected:
 				bool registered = false;
 			};
 		}
 	}
 }
+
+/**
+ * Components created through the TypeRegister (e.g. during deserialization) are allocated in their type pool.
+ */
+template <typename T>
+struct InstanceAllocator<T, typename std::enable_if<std::is_base_of<Tristeon::Core::Components::Component, T>::value>::type>
+{
+	static T* create()
+	{
+		T* component = new (Tristeon::Core::Components::ComponentPool::get<T>()) T();
+		component->typeID = Tristeon::Core::Components::ComponentTraits::getTypeID<T>();
+		return component;
+	}
+};
+
+/**
+ * Registered component types record which callbacks they implement, so ComponentManager can skip the ones they don't.
+ */
+template <typename T>
+struct TypeRegisterCallback<T, typename std::enable_if<std::is_base_of<Tristeon::Core::Components::Component, T>::value>::type>
+{
+	static void onRegister() { Tristeon::Core::Components::ComponentTraits::registerType<T>(); }
+};
@@ -2,6 +2,7 @@
 #include "Component.h"
 
 #include "Core/MessageBus.h"
+#include "Core/UserPrefs.h"
 #include "Misc/Console.h"
 
 namespace Tristeon
@@ -12,13 +13,22 @@ namespace Tristeon
 		{
 			ComponentManager::ComponentManager()
 			{
+				deterministic = UserPrefs::getBoolValue("DETERMINISTICUPDATE");
+
 				//Subscribe to message events regarding callbacks and (de)registering of components
-				MessageBus::subscribeToMessage(MT_SCRIPTINGCOMPONENT_REGISTER, [&](Message message) { registerComponent(message); });
-				MessageBus::subscribeToMessage(MT_SCRIPTINGCOMPONENT_DEREGISTER, [&](Message message) { deregisterComponent(message); });
-				MessageBus::subscribeToMessage(MT_START, [&](Message)       { callFunction<&Component::start>(); });
-				MessageBus::subscribeToMessage(MT_UPDATE, [&](Message)      { callFunction<&Component::update>(); });
-				MessageBus::subscribeToMessage(MT_LATEUPDATE, [&](Message)  { callFunction<&Component::lateUpdate>(); });
-				MessageBus::subscribeToMessage(MT_FIXEDUPDATE, [&](Message) { callFunction<&Component::fixedUpdate>(); });
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_SCRIPTINGCOMPONENT_REGISTER, [&](Message message) { registerComponent(message); }));
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_SCRIPTINGCOMPONENT_DEREGISTER, [&](Message message) { deregisterComponent(message); }));
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_START, [&](Message)       { callFunction<CC_START, &Component::start>(); }));
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_UPDATE, [&](Message)      { callFunction<CC_UPDATE, &Component::update>(); }));
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_LATEUPDATE, [&](Message)  { callFunction<CC_LATEUPDATE, &Component::lateUpdate>(); }));
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_FIXEDUPDATE, [&](Message) { callFunction<CC_FIXEDUPDATE, &Component::fixedUpdate>(); }));
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_AFTERFRAME, [&](Message)  { applyPendingChanges(); }));
+			}
+
+			ComponentManager::~ComponentManager()
+			{
+				for (MessageBus::Subscription const& subscription : subscriptions)
+					MessageBus::unsubscribeFromMessage(subscription);
 			}
 
 			void ComponentManager::registerComponent(Message msg)
@@ -26,7 +36,15 @@ namespace Tristeon
 				Misc::Console::t_assert(msg.userData != nullptr, "Trying to register a null component!");
 				Component* c = dynamic_cast<Component*>(msg.userData);
 				Misc::Console::t_assert(c != nullptr, "Failed to cast userData to component!");
-				components.push_back(c);
+
+				if (iterating > 0)
+				{
+					c->managerBucket = pendingBucket;
+					c->managerRow = pendingRegistrations.size();
+					pendingRegistrations.push_back(c);
+					return;
+				}
+				addToBucket(c);
 			}
 
 			void ComponentManager::deregisterComponent(Message msg)
@@ -34,8 +52,118 @@ namespace Tristeon
 				Misc::Console::t_assert(msg.userData != nullptr, "Trying to register a null component!");
 				Component* c = dynamic_cast<Component*>(msg.userData);
 				Misc::Console::t_assert(c != nullptr, "Failed to cast userData to component!");
-				if (components.size() != 0)
-					components.remove(c);
+
+				size_t const bucket = c->managerBucket;
+				size_t const row = c->managerRow;
+				c->managerBucket = unregisteredBucket;
+
+				if (bucket == unregisteredBucket)
+					return;
+				if (bucket == pendingBucket)
+				{
+					pendingRegistrations[row] = nullptr;
+					return;
+				}
+
+				if (iterating > 0)
+				{
+					//Leave an empty slot, the bucket may not be resized while it's being iterated
+					buckets[bucket].components[row] = nullptr;
+					pendingRemovals.push_back({ bucket, row });
+					return;
+				}
+				removeFromBucket(bucket, row);
+			}
+
+			void ComponentManager::addToBucket(Component* component)
+			{
+				size_t const bucket = getBucketIndex(typeid(*component));
+				component->managerBucket = bucket;
+				component->managerRow = buckets[bucket].components.size();
+				buckets[bucket].components.push_back(component);
+			}
+
+			void ComponentManager::removeFromBucket(size_t bucket, size_t row)
+			{
+				vector<Component*>& components = buckets[bucket].components;
+
+				//Empty slots at the end can simply be dropped
+				while (!components.empty() && components.back() == nullptr)
+					components.pop_back();
+				if (row >= components.size())
+					return;
+
+				if (row != components.size() - 1)
+				{
+					components[row] = components.back();
+					components[row]->managerRow = row;
+				}
+				components.pop_back();
+			}
+
+			void ComponentManager::applyPendingChanges()
+			{
+				if (iterating > 0)
+					return;
+
+				for (std::pair<size_t, size_t> const& removal : pendingRemovals)
+				{
+					//The slot may have been dropped and reused by an immediate change after the frame's callbacks finished
+					vector<Component*> const& components = buckets[removal.first].components;
+					if (removal.second < components.size() && components[removal.second] == nullptr)
+						removeFromBucket(removal.first, removal.second);
+				}
+				pendingRemovals.clear();
+
+				for (Component* c : pendingRegistrations)
+				{
+					if (c != nullptr)
+						addToBucket(c);
+				}
+				pendingRegistrations.clear();
+			}
+
+			size_t ComponentManager::getBucketIndex(std::type_index type)
+			{
+				auto const itr = bucketIndices.find(type);
+				if (itr != bucketIndices.end())
+					return itr->second;
+
+				size_t const index = buckets.size();
+				ComponentTypeInfo const info = ComponentTraits::getInfo(type);
+				bucketIndices[type] = index;
+				buckets.push_back(ComponentBucket(type, info));
+
+				//Only add the type to the dispatch lists of the callbacks it implements
+				for (ComponentCallback const callback : { CC_START, CC_UPDATE, CC_FIXEDUPDATE, CC_LATEUPDATE })
+				{
+					if (info.callbacks & callback)
+						dispatchLists[getDispatchIndex(callback)].push_back(index);
+				}
+				return index;
+			}
+
+			size_t ComponentManager::getDispatchIndex(ComponentCallback callback)
+			{
+				switch (callback)
+				{
+				case CC_START: return 0;
+				case CC_UPDATE: return 1;
+				case CC_FIXEDUPDATE: return 2;
+				case CC_LATEUPDATE: return 3;
+				default: throw std::invalid_argument("ComponentManager::getDispatchIndex expects a single callback!");
+				}
+			}
+
+			bool ComponentManager::canRunParallel(ComponentCallback callback, ComponentBucket const& bucket) const
+			{
+				if (deterministic || bucket.info.access == CA_SHARED)
+					return false;
+				if (callback != CC_UPDATE && callback != CC_FIXEDUPDATE)
+					return false;
+
+				//Not worth the scheduling overhead if everything fits in a single job
+				return bucket.components.size() > parallelBatchSize;
 			}
 		}
 	}
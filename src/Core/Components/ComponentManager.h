@@ -1,7 +1,14 @@
 ﻿#pragma once
 #include "Component.h"
+#include "ComponentTraits.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/MessageBus.h"
 #include "Misc/vector.h"
+#include "Misc/Profiler.h"
 #include <XPlatform/access.h>
+#include <array>
+#include <typeindex>
+#include <unordered_map>
 
 TRISTEON_UNIQUE_ACCESS_DECL()
 namespace Tristeon
@@ -15,9 +22,37 @@ namespace Tristeon
 		{
 			class Component;
 
+			/**
+			 * ComponentBucket groups all the registered components of a single concrete type.
+			 * Components of a type are allocated in their own ComponentPool, so walking a bucket touches contiguous memory.
+			 */
+			struct ComponentBucket
+			{
+				ComponentBucket(std::type_index type, ComponentTypeInfo info) : type(type), info(info) { }
+
+				std::type_index type;
+				/**
+				 * The callbacks implemented by this type, and the data it accesses
+				 */
+				ComponentTypeInfo info;
+				vector<Component*> components;
+			};
+
 			/**
 			 * ComponentManager keeps track of existing components and runs callbacks on them when needed.
 			 * ComponentManager implements a basic (de)register system that listens to the initailization of new components.
+			 * Registered components are grouped per type, callbacks are executed type by type.
+			 * Every callback has its own dispatch list that only contains the types that implement said callback,
+			 * types that inherit the empty default from Component are never visited.
+			 *
+			 * Types that declare their data access (see ComponentAccess) are updated in parallel on the JobSystem during update and fixedUpdate.
+			 * Types are still processed one after another, so the order between types is the same as in the serial path.
+			 * The DETERMINISTICUPDATE user pref disables parallel updates, which is required for replays.
+			 *
+			 * Components that are registered or deregistered while callbacks are running don't modify the buckets directly.
+			 * Registrations are queued, deregistrations leave an empty slot that is skipped. Both are applied in bulk at MT_AFTERFRAME.
+			 * Removal swaps the last component of the bucket into the empty slot, so it takes constant time regardless of the amount of components.
+			 * Newly registered components thus receive their first callbacks in the frame after they were created.
 			 *
 			 * This class is not intended to be accessed or used by users.
 			 */
@@ -27,9 +62,13 @@ namespace Tristeon
 
 				ComponentManager();
 				/**
-				 * Calls function f on every registered component
+				 * Unsubscribes from the message bus, messages sent after this point (e.g. by components that are destroyed later) are ignored
 				 */
-				template <void (Component::*func)()>
+				~ComponentManager();
+				/**
+				 * Calls function func on every registered component whose type implements the given callback
+				 */
+				template <ComponentCallback callback, void (Component::*func)()>
 				void callFunction();
 
 				/**
@@ -42,14 +81,110 @@ namespace Tristeon
 				 * \exception runtime_error If msg.userData is null or if msg.userData can not successfuly cast to Component
 				 */
 				void deregisterComponent(Message msg);
-				vector<Component*> components;
+				/**
+				 * Adds the component to the bucket of its type
+				 */
+				void addToBucket(Component* component);
+				/**
+				 * Removes the component at the given row by moving the last component of the bucket into its place
+				 */
+				void removeFromBucket(size_t bucket, size_t row);
+				/**
+				 * Applies the registrations and deregistrations that were deferred while callbacks were running
+				 */
+				void applyPendingChanges();
+				/**
+				 * Returns the index of the bucket for the given type, creates a new bucket if there isn't any
+				 */
+				size_t getBucketIndex(std::type_index type);
+
+				/**
+				 * Returns the index of the dispatch list of the given callback
+				 */
+				static size_t getDispatchIndex(ComponentCallback callback);
+
+				/**
+				 * Returns true if the components in the given bucket can execute the given callback in parallel
+				 */
+				bool canRunParallel(ComponentCallback callback, ComponentBucket const& bucket) const;
+
+				/**
+				 * The amount of components that is updated by a single job
+				 */
+				static const size_t parallelBatchSize = 64;
+
+				/**
+				 * If true, every component is updated serially in registration order
+				 */
+				bool deterministic = false;
+
+				/**
+				 * Component::managerBucket of components that aren't registered, and of components whose registration is deferred
+				 */
+				static const size_t unregisteredBucket = SIZE_MAX;
+				static const size_t pendingBucket = SIZE_MAX - 1;
+
+				/**
+				 * The amount of callFunction calls that are currently running. Structural changes are deferred while this isn't 0.
+				 */
+				int iterating = 0;
+				/**
+				 * Components that were registered while iterating. Entries are set to nullptr if the component is destroyed before it's added.
+				 */
+				vector<Component*> pendingRegistrations;
+				/**
+				 * The bucket and row of every slot that was emptied while iterating
+				 */
+				vector<std::pair<size_t, size_t>> pendingRemovals;
+
+				vector<ComponentBucket> buckets;
+				/**
+				 * The bucket indices of the types that implement start, update, fixedUpdate and lateUpdate respectively
+				 */
+				std::array<vector<size_t>, 4> dispatchLists;
+				/**
+				 * Maps component types to their index in buckets
+				 */
+				std::unordered_map<std::type_index, size_t> bucketIndices;
+
+				vector<MessageBus::Subscription> subscriptions;
 			};
 
-			template <void(Component::*func)()>
+			template <ComponentCallback callback, void(Component::*func)()>
 			void ComponentManager::callFunction()
 			{
-				for (Component* c : components)
-					(c->*func)();
+				TRISTEON_PROFILE_SCOPE("ComponentManager::callFunction");
+				iterating++;
+
+				vector<size_t> const& dispatchList = dispatchLists[getDispatchIndex(callback)];
+				for (size_t i = 0; i < dispatchList.size(); i++)
+				{
+					vector<Component*>& components = buckets[dispatchList[i]].components;
+					//A zone per component type, named after the type
+					TRISTEON_PROFILE_SCOPE(buckets[dispatchList[i]].type.name());
+
+					if (canRunParallel(callback, buckets[dispatchList[i]]))
+					{
+						Jobs::JobSystem::parallelFor(components.size(), parallelBatchSize, [&](size_t begin, size_t end)
+						{
+							for (size_t j = begin; j < end; j++)
+							{
+								if (components[j] != nullptr)
+									(components[j]->*func)();
+							}
+						});
+						continue;
+					}
+
+					//Indexed on purpose, the callbacks may deregister components (which empties their slot) but never resize the bucket
+					for (size_t j = 0; j < components.size(); j++)
+					{
+						if (components[j] != nullptr)
+							(components[j]->*func)();
+					}
+				}
+
+				iterating--;
 			}
 		}
 	}
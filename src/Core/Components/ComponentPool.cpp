@@ -0,0 +1,66 @@
+﻿#include "ComponentPool.h"
+#include <new>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Components
+		{
+			ComponentPool::ComponentPool(std::size_t objectSize) : objectSize(objectSize)
+			{
+				//Round the slot size up to the header alignment so that every object in a chunk stays aligned
+				slotSize = headerSize + (objectSize + headerSize - 1) / headerSize * headerSize;
+			}
+
+			void* ComponentPool::allocate()
+			{
+				if (available.empty())
+					addChunk();
+
+				unsigned char* slot = available.back();
+				available.pop_back();
+
+				//Store ourselves in the header so deallocate() knows where the memory came from
+				*reinterpret_cast<ComponentPool**>(slot) = this;
+				return slot + headerSize;
+			}
+
+			void* ComponentPool::allocateUnpooled(std::size_t size)
+			{
+				unsigned char* slot = static_cast<unsigned char*>(::operator new(headerSize + size));
+				*reinterpret_cast<ComponentPool**>(slot) = nullptr;
+				return slot + headerSize;
+			}
+
+			void ComponentPool::deallocate(void* object)
+			{
+				if (object == nullptr)
+					return;
+
+				unsigned char* slot = static_cast<unsigned char*>(object) - headerSize;
+				ComponentPool* pool = *reinterpret_cast<ComponentPool**>(slot);
+				if (pool != nullptr)
+					pool->release(slot);
+				else
+					::operator delete(slot);
+			}
+
+			void ComponentPool::release(unsigned char* slot)
+			{
+				available.push_back(slot);
+			}
+
+			void ComponentPool::addChunk()
+			{
+				std::unique_ptr<unsigned char[]> chunk(new unsigned char[slotSize * slotsPerChunk]);
+
+				//Push in reverse so that allocate() hands out slots in ascending address order
+				for (std::size_t i = slotsPerChunk; i > 0; --i)
+					available.push_back(chunk.get() + (i - 1) * slotSize);
+
+				chunks.push_back(std::move(chunk));
+			}
+		}
+	}
+}
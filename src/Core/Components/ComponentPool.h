@@ -0,0 +1,93 @@
+﻿#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Components
+		{
+			/**
+			 * ComponentPool is a chunked allocator that stores the components of a single type in contiguous blocks of memory,
+			 * so that iterating over all components of a type walks memory linearly instead of chasing scattered heap pointers.
+			 *
+			 * Every slot is prefixed with a small header that stores the pool that owns it.
+			 * This allows Component::operator delete to return the memory to the right pool without knowing the concrete type.
+			 *
+			 * This class is not intended to be accessed or used by users. Use GameObject::addComponent<T>() instead.
+			 */
+			class ComponentPool final
+			{
+			public:
+				/**
+				 * Creates a pool for objects of the given size
+				 */
+				explicit ComponentPool(std::size_t objectSize);
+
+				/**
+				 * Returns the pool that is used for components of type T.
+				 * The pool is intentionally never destroyed, components owned by static objects might still be released during static destruction.
+				 */
+				template <typename T>
+				static ComponentPool& get();
+
+				/**
+				 * Returns memory for a single object from the pool. Allocates a new chunk if there are no free slots available.
+				 */
+				void* allocate();
+
+				/**
+				 * Allocates memory for an object that isn't owned by any pool, using the same header layout as pooled objects.
+				 */
+				static void* allocateUnpooled(std::size_t size);
+
+				/**
+				 * Releases memory that was allocated through allocate() or allocateUnpooled(). Nullptr is ignored.
+				 */
+				static void deallocate(void* object);
+
+				/**
+				 * The size of an object of this pool
+				 */
+				std::size_t getObjectSize() const { return objectSize; }
+			private:
+				/**
+				 * Puts the given slot back into the list of available slots
+				 */
+				void release(unsigned char* slot);
+
+				/**
+				 * Allocates a new chunk of slotsPerChunk slots and adds them to the available list
+				 */
+				void addChunk();
+
+				/**
+				 * The size of the header that precedes every object. Keeps objects aligned for any fundamental type.
+				 */
+				static const std::size_t headerSize = alignof(std::max_align_t);
+				/**
+				 * The amount of objects that are stored contiguously in a single chunk
+				 */
+				static const std::size_t slotsPerChunk = 256;
+
+				std::size_t objectSize;
+				std::size_t slotSize;
+
+				std::vector<std::unique_ptr<unsigned char[]>> chunks;
+				/**
+				 * The free slots, used as a stack so recently released (warm) memory is reused first
+				 */
+				std::vector<unsigned char*> available;
+			};
+
+			template <typename T>
+			ComponentPool& ComponentPool::get()
+			{
+				static ComponentPool* pool = new ComponentPool(sizeof(T));
+				return *pool;
+			}
+		}
+	}
+}
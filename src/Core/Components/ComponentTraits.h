@@ -0,0 +1,146 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Components
+		{
+			class Component;
+
+			/**
+			 * Describes the engine callbacks a component type can implement. Used as bit flags.
+			 */
+			enum ComponentCallback : uint8_t
+			{
+				CC_NONE = 0,
+				CC_START = 1 << 0,
+				CC_UPDATE = 1 << 1,
+				CC_FIXEDUPDATE = 1 << 2,
+				CC_LATEUPDATE = 1 << 3,
+				CC_ALL = CC_START | CC_UPDATE | CC_FIXEDUPDATE | CC_LATEUPDATE
+			};
+
+			/**
+			 * Describes the data a component type accesses in its update and fixedUpdate callbacks. Used as bit flags.
+			 * Component types declare their access through a static componentAccess member:
+			 *		static const uint8_t componentAccess = Core::Components::CA_OWN_TRANSFORM;
+			 *
+			 * Types that declare any access besides CA_SHARED promise to not touch other objects, not to add/remove components or gameobjects,
+			 * and not to send messages during those callbacks. Their instances can then be updated in parallel.
+			 */
+			enum ComponentAccess : uint8_t
+			{
+				/**
+				 * The default. The component might access anything, and always runs serially on the main thread.
+				 */
+				CA_SHARED = 0,
+				/**
+				 * The component reads and writes its own members, and only reads global state (time, input).
+				 */
+				CA_SELF = 1 << 0,
+				/**
+				 * The component reads and writes the local values of the transform it's attached to.
+				 * Types with this flag are expected to be attached at most once per gameobject.
+				 */
+				CA_OWN_TRANSFORM = 1 << 1
+			};
+
+			/**
+			 * The information ComponentManager needs about a component type
+			 */
+			struct ComponentTypeInfo
+			{
+				/**
+				 * The callbacks (ComponentCallback flags) implemented by the type
+				 */
+				uint8_t callbacks;
+				/**
+				 * The data (ComponentAccess flags) accessed by the type
+				 */
+				uint8_t access;
+			};
+
+			/**
+			 * Detects at compile time which of Component's callbacks are overriden by T.
+			 * If T inherits a callback from Component, &T::callback has type void (Component::*)().
+			 */
+			template <typename T>
+			struct ComponentCallbackTraits
+			{
+				typedef void (Component::*Callback_t)();
+
+				static const uint8_t value =
+					(std::is_same<decltype(&T::start), Callback_t>::value ? 0 : CC_START) |
+					(std::is_same<decltype(&T::update), Callback_t>::value ? 0 : CC_UPDATE) |
+					(std::is_same<decltype(&T::fixedUpdate), Callback_t>::value ? 0 : CC_FIXEDUPDATE) |
+					(std::is_same<decltype(&T::lateUpdate), Callback_t>::value ? 0 : CC_LATEUPDATE);
+			};
+
+			/**
+			 * ComponentTraits stores the callbacks that every known component type implements, and the data it accesses.
+			 * Types are recorded by the TypeRegister (REGISTER_TYPE) and by GameObject::addComponent<T>,
+			 * so that ComponentManager only dispatches callbacks to components that actually implement them.
+			 */
+			class ComponentTraits final
+			{
+			public:
+				/**
+				 * Records the type info of component type T. Only writes to the map the first time it's called for T.
+				 */
+				template <typename T>
+				static void registerType()
+				{
+					ComponentTypeInfo const info = { ComponentCallbackTraits<T>::value, T::componentAccess };
+					static bool const registered = getMap().emplace(typeid(T), info).second;
+					(void)registered;
+				}
+
+				/**
+				 * Returns a small sequential ID for component type T, assigned on first use. Doesn't rely on RTTI.
+				 * Used by GameObject for its constant time component lookup.
+				 */
+				template <typename T>
+				static uint32_t getTypeID()
+				{
+					static uint32_t const id = getTypeCounter()++;
+					return id;
+				}
+
+				/**
+				 * The type ID of components that were created without knowing their concrete type
+				 */
+				static const uint32_t invalidTypeID = UINT32_MAX;
+
+				/**
+				 * Returns the type info of the given type. 
+				 * Unknown types receive every callback (CC_ALL) and are treated as accessing shared data (CA_SHARED).
+				 */
+				static ComponentTypeInfo getInfo(std::type_index type)
+				{
+					auto const itr = getMap().find(type);
+					if (itr != getMap().end())
+						return itr->second;
+					return { CC_ALL, CA_SHARED };
+				}
+			private:
+				static std::atomic<uint32_t>& getTypeCounter()
+				{
+					static std::atomic<uint32_t> counter(0);
+					return counter;
+				}
+
+				static std::unordered_map<std::type_index, ComponentTypeInfo>& getMap()
+				{
+					static std::unordered_map<std::type_index, ComponentTypeInfo> instance;
+					return instance;
+				}
+			};
+		}
+	}
+}
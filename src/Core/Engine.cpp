@@ -9,18 +9,67 @@
 #include "Components/ComponentManager.h"
 #include "Scenes/SceneManager.h"
 #include "MessageBus.h"
+#include "TransformStore.h"
 #include "Misc/Hardware/Time.h"
+#include "Misc/Profiler.h"
+#include "Misc/FrameStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
 
 namespace Tristeon
 {
 	namespace Core
 	{
-		Engine::Engine()
+		Engine::Engine(int argc, char** argv)
 		{
 			UserPrefs::readPrefs();
+			UserPrefs::readArguments(argc, argv);
+
+			//Capturing starts before the subsystems are created, so that their startup is part of the capture
+			profileOutput = UserPrefs::getStringValue("PROFILEOUTPUT");
+			profileFrames = UserPrefs::getIntValue("PROFILEFRAMES");
+			if (!profileOutput.empty())
+			{
+#ifdef TRISTEON_PROFILER
+				TRISTEON_PROFILE_THREAD("Main thread");
+				Misc::Profiler::beginCapture();
+#else
+				Misc::Console::warning("PROFILEOUTPUT is set but the engine was built without TRISTEON_PROFILER, nothing will be captured.");
+				profileOutput.clear();
+#endif
+			}
+
+			const float fixedDelta = UserPrefs::getFloatValue("FIXEDDELTATIME");
+			if (fixedDelta > 0)
+				Misc::Time::fixedDeltaTime = fixedDelta;
+			else
+				Misc::Console::warning("FIXEDDELTATIME has to be larger than 0, using the default of " + std::to_string(Misc::Time::fixedDeltaTime) + " instead");
+			maxFixedSteps = std::max(UserPrefs::getIntValue("MAXFIXEDSTEPS"), 1);
+
+			Misc::FrameStats::hitchThreshold = UserPrefs::getFloatValue("FRAMEHITCHTHRESHOLD");
+			frameStatsOutput = UserPrefs::getStringValue("FRAMESTATSOUTPUT");
+
+			headless = UserPrefs::getBoolValue("HEADLESS");
+#ifdef TRISTEON_EDITOR
+			if (headless)
+			{
+				Misc::Console::warning("The editor can't run headless, HEADLESS is ignored.");
+				headless = false;
+			}
+#endif
+			tickRate = UserPrefs::getFloatValue("HEADLESSTICKRATE");
+			maxFrames = UserPrefs::getIntValue("HEADLESSFRAMES");
+
+			//The job system is created first so that every other subsystem can schedule work
+			jobSys = std::make_unique<Jobs::JobSystem>();
 
 			const std::string api = UserPrefs::getStringValue("RENDERAPI");
-			if (api == "VULKAN")
+			if (headless)
+				Misc::Console::write("Running headless, no window, input or renderer will be created.");
+			else if (api == "VULKAN")
 			{
 				VulkanBindingData* bindingData = VulkanBindingData::getInstance();
 
@@ -35,32 +84,63 @@ namespace Tristeon
 			else
 				Misc::Console::error(api + " is not supported as a rendering API!");
 
-			inputSys = std::make_unique<Managers::InputManager>(window->window);
+			if (window != nullptr)
+				inputSys = std::make_unique<Managers::InputManager>(window->window);
 			componentSys = std::make_unique<Components::ComponentManager>();
 			sceneSys = std::make_unique<Scenes::SceneManager>();
 
-			MessageBus::subscribeToMessage(MT_GAME_LOGIC_START, [&](Message msg)
+			subscriptions.push_back(MessageBus::subscribeToMessage(MT_GAME_LOGIC_START, [&](Message msg)
 			{
 				MessageBus::sendMessage(MT_START);
 				inPlayMode = true;
-			});
-			MessageBus::subscribeToMessage(MT_GAME_LOGIC_STOP, [&](Message msg) { inPlayMode = false; });
+			}));
+			subscriptions.push_back(MessageBus::subscribeToMessage(MT_GAME_LOGIC_STOP, [&](Message msg) { inPlayMode = false; }));
+		}
+
+		Engine::~Engine()
+		{
+			for (MessageBus::Subscription const& subscription : subscriptions)
+				MessageBus::unsubscribeFromMessage(subscription);
 		}
 
 		void Engine::run() const
 		{
-			double lastTime = glfwGetTime();
+			using clock = std::chrono::steady_clock;
+
+			clock::time_point lastTime = clock::now();
 			float fixedUpdateTime = 0;
 			int frames = 0;
 			float time = 0;
 
-			while (!glfwWindowShouldClose(window->window))
+			//Headless engines tick at a fixed rate, or as fast as possible if the rate isn't positive
+			clock::duration const tickDuration = tickRate > 0 ? std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / tickRate)) : clock::duration::zero();
+			int frameCount = 0;
+
+			while (headless ? maxFrames <= 0 || frameCount < maxFrames : !glfwWindowShouldClose(window->window))
 			{
-				glfwPollEvents();
+				//The capture is written before the next frame starts, once every zone of the last captured frame has been closed (including the render thread's)
+				if (profileFrames > 0 && frameCount == profileFrames)
+				{
+					Rendering::RenderThread::sync();
+					writeProfile();
+				}
+
+				TRISTEON_PROFILE_SCOPE("Engine::frame");
+				clock::time_point const frameStart = clock::now();
+				frameCount++;
+
+				if (!headless)
+				{
+					TRISTEON_PROFILE_SCOPE("glfwPollEvents");
+					glfwPollEvents();
+				}
+
+				//Deliver the messages that other threads have posted since the last frame
+				MessageBus::dispatchPostedMessages();
 
 				//Keep track of elapsed time and frames and calculate FPS
-				Misc::Time::deltaTime = glfwGetTime() - lastTime;
-				lastTime = glfwGetTime();
+				Misc::Time::deltaTime = std::chrono::duration<float>(frameStart - lastTime).count();
+				lastTime = frameStart;
 				frames++;
 				time += Misc::Time::deltaTime;
 				if (time >= 1)
@@ -72,28 +152,89 @@ namespace Tristeon
 
 				if (inPlayMode)
 				{
+					TRISTEON_PROFILE_SCOPE("Engine::simulate");
+
 					//FixedUpdate runs a fixed amount of times per second, the loop makes sure to catch up if we happen to be behind
-					fixedUpdateTime += Misc::Time::deltaTime;
-					while (fixedUpdateTime > 1.0f / 50.0f) //TODO: Make fixed delta time variable
 					{
-						MessageBus::sendMessage(MT_FIXEDUPDATE);
-						fixedUpdateTime -= 1.0f / 50.0f;
+						Misc::FramePhaseTimer const timer(Misc::FP_FIXEDUPDATE);
+						float const fixedDelta = Misc::Time::fixedDeltaTime;
+						fixedUpdateTime += Misc::Time::deltaTime;
+						int steps = 0;
+						while (fixedUpdateTime >= fixedDelta && steps < maxFixedSteps)
+						{
+							MessageBus::sendMessage(MT_FIXEDUPDATE);
+							fixedUpdateTime -= fixedDelta;
+							steps++;
+						}
+						//Catching up is capped so that a single long frame (e.g. a scene load) can't cause a spiral of fixed updates, the time that's left is dropped
+						if (fixedUpdateTime >= fixedDelta)
+							fixedUpdateTime = std::fmod(fixedUpdateTime, fixedDelta);
+						Misc::Time::interpolationAlpha = fixedUpdateTime / fixedDelta;
 					}
 
+					Misc::FramePhaseTimer const timer(Misc::FP_UPDATE);
 					MessageBus::sendMessage(MT_UPDATE);
 					MessageBus::sendMessage(MT_LATEUPDATE);
 				}
 
-				//Only attempt to render if the window is a valid size
-				if (window->width.get() != 0 && window->height.get() != 0)
+				//Only attempt to render if the window is a valid size. Headless engines send the render phases as well so that components behave the same
+				if (headless || (window->width.get() != 0 && window->height.get() != 0))
 				{
-					MessageBus::sendMessage(MT_PRERENDER);
-					MessageBus::sendMessage(MT_RENDER);
+					TRISTEON_PROFILE_SCOPE("Engine::render");
+
+					{
+						Misc::FramePhaseTimer const timer(Misc::FP_PRERENDER);
+
+						//Bring every world matrix up to date in a single pass, rather than lazily per transform while rendering
+						{
+							TRISTEON_PROFILE_SCOPE("TransformStore::update");
+							TransformStore::update();
+						}
+						MessageBus::sendMessage(MT_PRERENDER);
+					}
+					{
+						Misc::FramePhaseTimer const timer(Misc::FP_RENDER);
+						MessageBus::sendMessage(MT_RENDER);
+					}
 					MessageBus::sendMessage(MT_POSTRENDER);
+				}
+
+				//Deferred changes are applied here, so this has to be sent even if nothing was rendered
+				MessageBus::sendMessage(MT_AFTERFRAME);
+
+				//The idle time of headless engines isn't part of the frame
+				Misc::FrameStats::endFrame(clock::now() - frameStart);
 
-					MessageBus::sendMessage(MT_AFTERFRAME);
+				if (headless && tickDuration > clock::duration::zero())
+				{
+					TRISTEON_PROFILE_SCOPE("Engine::waitForTick");
+					std::this_thread::sleep_until(frameStart + tickDuration);
 				}
 			}
+
+			//The last frame might still be rendering, it has to finish before the window is destroyed
+			Rendering::RenderThread::sync();
+
+			writeProfile();
+
+			if (!frameStatsOutput.empty())
+			{
+				if (Misc::FrameStats::writeCSV(frameStatsOutput))
+					Misc::Console::write("Wrote frame statistics to " + frameStatsOutput);
+				else
+					Misc::Console::warning("Failed to write frame statistics to " + frameStatsOutput);
+			}
+		}
+
+		void Engine::writeProfile() const
+		{
+			if (profileOutput.empty() || !Misc::Profiler::isCapturing())
+				return;
+
+			if (Misc::Profiler::endCapture(profileOutput))
+				Misc::Console::write("Wrote profiler capture to " + profileOutput);
+			else
+				Misc::Console::warning("Failed to write profiler capture to " + profileOutput);
 		}
 	}
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <Core/Rendering/RenderManager.h>
 #include <Scenes/SceneManager.h>
 #include <Core/Components/ComponentManager.h>
+#include <Core/Jobs/JobSystem.h>
+#include <Core/MessageBus.h>
 
 namespace Tristeon
 {
@@ -19,16 +21,23 @@ namespace Tristeon
 		class Engine final
 		{
 		public:
-			Engine();
+			/**
+			 * Creates the engine subsystems. User prefs can be overridden through the command line arguments, e.g. --HEADLESS
+			 */
+			Engine(int argc, char** argv);
+			~Engine();
 			/**
 			 * Starts the main engine loop. 
 			 * Warning: This function starts an (almost) infinite loop. As such it only returns once the Engine closes.
+			 * Headless engines return after HEADLESSFRAMES frames, or never if it isn't positive.
 			 * 
 			 * \exception runtime_error Unsupported rendering API requested
 			 */
 			void run() const;
 
 		private:
+			//Declared first so that it's destroyed last, other subsystems might still wait on jobs during destruction
+			std::unique_ptr<Jobs::JobSystem> jobSys;
 			std::unique_ptr<Rendering::RenderManager> renderSys;
 			std::unique_ptr<Scenes::SceneManager> sceneSys;
 			std::unique_ptr<Rendering::Window> window;
@@ -36,6 +45,43 @@ namespace Tristeon
 			std::unique_ptr<Managers::InputManager> inputSys;
 
 			bool inPlayMode = false;
+			/**
+			 * The maximum amount of fixed updates per frame, configured through the MAXFIXEDSTEPS user pref
+			 */
+			int maxFixedSteps = 5;
+
+			/**
+			 * Headless engines don't create a window, input or renderer. Scenes are still loaded and every phase is still sent.
+			 */
+			bool headless = false;
+			/**
+			 * The amount of frames per second when running headless, frames aren't limited if this isn't positive
+			 */
+			float tickRate = 60;
+			/**
+			 * The amount of frames a headless engine runs before run() returns, it runs until it's killed if this isn't positive
+			 */
+			int maxFrames = 0;
+
+			/**
+			 * Ends the profiler capture that was started through PROFILEOUTPUT and writes it to said file
+			 */
+			void writeProfile() const;
+			/**
+			 * The file that the profiler capture is written to, nothing is captured if this is empty
+			 */
+			std::string profileOutput;
+			/**
+			 * The amount of frames that is captured, the capture lasts until the engine closes if this isn't positive
+			 */
+			int profileFrames = 0;
+
+			/**
+			 * The file that the frame statistics are written to when the engine closes, nothing is written if this is empty
+			 */
+			std::string frameStatsOutput;
+
+			std::vector<MessageBus::Subscription> subscriptions;
 		};
 	}
 }
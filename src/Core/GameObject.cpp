@@ -8,11 +8,16 @@ namespace Tristeon
 	{
 		REGISTER_TYPE_CPP(GameObject)
 
-		GameObject::GameObject()
+		GameObject::GameObject() : handle(HandleTable<GameObject>::create(this))
 		{
 			_transform = std::make_unique<Transform>();
 		}
 
+		GameObject::~GameObject()
+		{
+			HandleTable<GameObject>::destroy(handle);
+		}
+
 		void GameObject::init()
 		{
 			for (unsigned int i = 0; i < components.size(); i++)
@@ -23,7 +28,7 @@ namespace Tristeon
 		{
 			nlohmann::json output;
 			output["typeID"] = TRISTEON_TYPENAME(GameObject);
-			output["instanceID"] = getInstanceID();
+			output["instanceID"] = instanceIDToString(getInstanceID());
 			output["active"] = active;
 			output["name"] = name;
 			output["tag"] = tag;
@@ -42,7 +47,8 @@ namespace Tristeon
 
 		void GameObject::deserialize(nlohmann::json json)
 		{
-			GET_STRING(instanceID, "instanceID");
+			const std::string instanceIDValue = json["instanceID"];
+			instanceID = instanceIDFromString(instanceIDValue);
 			active = json["active"];
 			GET_STRING(name, "name");
 			GET_STRING(tag, "tag");
@@ -52,6 +58,8 @@ namespace Tristeon
 			}
 			_transform->deserialize(json["transform"]);
 			components.clear();
+			componentMask = 0;
+			componentSlots.clear();
 			for (auto serializedComponent : json["components"])
 			{
 				//TODO: instead of recreating identify already existing components instead of removing those and load those
@@ -66,8 +74,31 @@ namespace Tristeon
 				serializable.release();
 				std::unique_ptr<Components::Component> sharedComponent(component);
 				sharedComponent->deserialize(serializedComponent);
-				components.push_back(std::move(sharedComponent));
+				addComponentInternal(std::move(sharedComponent));
 			}
+			onComponentsChanged();
+		}
+
+		void GameObject::addComponentInternal(std::unique_ptr<Components::Component> component)
+		{
+			uint32_t const id = component->typeID;
+			if (id < maxLookupTypes)
+			{
+				//Only the first component of a type is stored in the lookup
+				uint64_t const bit = uint64_t(1) << id;
+				if ((componentMask & bit) == 0)
+				{
+					componentSlots.insert(componentSlots.begin() + popcount64(componentMask & (bit - 1)), component.get());
+					componentMask |= bit;
+				}
+			}
+			components.push_back(std::move(component));
+		}
+
+		void GameObject::onComponentsChanged()
+		{
+			if (scene != nullptr)
+				scene->updateArchetype(this);
 		}
 	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Components/Component.h"
 #include "Editor/TypeRegister.h"
 #include "Misc/Console.h"
+#include "XPlatform/popcount.h"
 #include <memory>
 
 namespace Tristeon
@@ -31,8 +32,14 @@ namespace Tristeon
 #endif
 		public:
 			GameObject();
+			~GameObject();
 			std::string tag;
 
+			/**
+			 * Returns a handle to this gameobject. The handle resolves to nullptr once the gameobject is destroyed.
+			 */
+			Handle<GameObject> getHandle() const { return handle; }
+
 			/**
 			* The transform of the gameobject. Describes position, rotation, scale and a parent-child structure.
 			*/
@@ -47,9 +54,15 @@ namespace Tristeon
 
 			/**
 			 * Gets the first component of the given type T. Null if no matching component can be found.
+			 * Concrete types are matched exactly in constant time. Abstract types (e.g. Renderer) fall back to a scan over all components.
 			 */
 			template <typename T> T* getComponent();
 
+			/**
+			 * Returns true if the gameobject has a component of type T. Uses the same matching rules as getComponent<T>().
+			 */
+			template <typename T> bool hasComponent();
+
 			/**
 			 * Gets all the components of type T. Will return an empty vector if no components can be found.
 			 */
@@ -57,6 +70,11 @@ namespace Tristeon
 
 			nlohmann::json serialize() override;
 			void deserialize(nlohmann::json json) override;
+
+			/**
+			 * The amount of component types that are supported by the constant time lookup. Types with a higher ID fall back to a scan.
+			 */
+			static const uint32_t maxLookupTypes = 64;
 		private:
 			/**
 			 * Initializes all the gameobjects' components. 
@@ -64,6 +82,55 @@ namespace Tristeon
 			 */
 			void init();
 
+			/**
+			 * Adds the component to the component list and the type lookup
+			 */
+			void addComponentInternal(std::unique_ptr<Components::Component> component);
+
+			/**
+			 * Notifies the scene that our set of components has changed, so it can move us to the right archetype
+			 */
+			void onComponentsChanged();
+
+			/**
+			 * Returns true if the component matches type T, see getComponent<T>()
+			 */
+			template <typename T> static bool isComponentOfType(Components::Component* component);
+
+			/**
+			 * Returns the type ID of T for the constant time lookup, or ComponentTraits::invalidTypeID if T is abstract.
+			 * Abstract types are never assigned an ID, so they don't take up one of the maxLookupTypes IDs that concrete types need.
+			 */
+			template <typename T> static uint32_t getLookupTypeID() { return getLookupTypeID<T>(std::is_abstract<T>()); }
+			template <typename T> static uint32_t getLookupTypeID(std::true_type) { return Components::ComponentTraits::invalidTypeID; }
+			template <typename T> static uint32_t getLookupTypeID(std::false_type) { return Components::ComponentTraits::getTypeID<T>(); }
+
+			/**
+			 * A bit for every component type ID that's attached to this gameobject
+			 */
+			uint64_t componentMask = 0;
+			/**
+			 * The first component of every type in componentMask, ordered by type ID.
+			 * The slot of a type is the amount of bits set in the mask below its ID.
+			 */
+			std::vector<Components::Component*> componentSlots;
+
+			Handle<GameObject> handle;
+
+			/**
+			 * The scene that owns this gameobject, nullptr if it isn't part of a scene
+			 */
+			Scenes::Scene* scene = nullptr;
+			/**
+			 * The archetype table and row of this gameobject in its scene
+			 */
+			size_t archetypeIndex = 0;
+			size_t archetypeRow = 0;
+			/**
+			 * The index of this gameobject in Scene::gameObjects
+			 */
+			size_t sceneIndex = 0;
+
 			std::unique_ptr<Transform> _transform;
 			std::vector<std::unique_ptr<Components::Component>> components;
 
@@ -81,29 +148,54 @@ namespace Tristeon
 		template <typename T>
         typename std::enable_if<std::is_base_of<Components::Component, T>::value, T>::type* GameObject::addComponent()
 		{
-			T* component = new T();
+			//Allocate in the type pool so components of the same type are stored contiguously
+			T* component = new (Components::ComponentPool::get<T>()) T();
+			Components::ComponentTraits::registerType<T>();
+			component->typeID = Components::ComponentTraits::getTypeID<T>();
 			component->setup(this);
-			components.push_back(std::move(std::unique_ptr<T>(component)));
+			addComponentInternal(std::unique_ptr<Components::Component>(component));
+			onComponentsChanged();
 			return component;
 		}
 
+		template <typename T>
+		bool GameObject::isComponentOfType(Components::Component* component)
+		{
+			//Abstract types never have exact instances, so they require a cast
+			if (std::is_abstract<T>::value)
+				return dynamic_cast<T*>(component) != nullptr;
+			return component->typeID == Components::ComponentTraits::getTypeID<T>();
+		}
+
 		template <typename T>
 		T* GameObject::getComponent()
 		{
-			if (!std::is_base_of<Components::Component, T>())
+			static_assert(std::is_base_of<Components::Component, T>::value, "Type T is not of type Component in getComponent<T>!");
+
+			//Abstract types get an invalid ID, which makes them fall back to the scan
+			uint32_t const id = getLookupTypeID<T>();
+			if (id < maxLookupTypes)
 			{
-				Misc::Console::error("Type T is not of type Component in getComponent<T>!");
-				return nullptr;
+				uint64_t const bit = uint64_t(1) << id;
+				if ((componentMask & bit) == 0)
+					return nullptr;
+				return static_cast<T*>(componentSlots[popcount64(componentMask & (bit - 1))]);
 			}
 
-			for (int i = 0; i < components.size(); i++)
+			for (size_t i = 0; i < components.size(); i++)
 			{
-				if (dynamic_cast<T>(components[i].get()) != nullptr)
-					return components[i].get();
+				if (isComponentOfType<T>(components[i].get()))
+					return static_cast<T*>(components[i].get());
 			}
 			return nullptr;
 		}
 
+		template <typename T>
+		bool GameObject::hasComponent()
+		{
+			return getComponent<T>() != nullptr;
+		}
+
 		/**
 		 * Overrides getComponent for T = Transform
 		 * \return Returns the transform component
@@ -117,17 +209,19 @@ namespace Tristeon
 		template <typename T>
 		std::vector<T*> GameObject::getComponents()
 		{
-			if (!std::is_base_of<Components::Component, T>())
-			{
-				Misc::Console::error("Type T is not of type Component in getComponents<T>!");
-				return nullptr;
-			}
+			static_assert(std::is_base_of<Components::Component, T>::value, "Type T is not of type Component in getComponents<T>!");
+
+			std::vector<T*> result;
+
+			//Early out through the type mask if the gameobject doesn't have any component of type T
+			uint32_t const id = getLookupTypeID<T>();
+			if (id < maxLookupTypes && (componentMask & (uint64_t(1) << id)) == 0)
+				return result;
 
-			std::vector<Components::Component*> result;
-			for (int i = 0; i < components.size(); i++)
+			for (size_t i = 0; i < components.size(); i++)
 			{
-				if (dynamic_cast<T>(components[i].get()) != nullptr)
-					result.push_back(components[i].get());
+				if (isComponentOfType<T>(components[i].get()))
+					result.push_back(static_cast<T*>(components[i].get()));
 			}
 			return result;
 		}
@@ -0,0 +1,125 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		template <typename T> class HandleTable;
+
+		/**
+		 * Handle is a weak reference to an object of type T, made of a slot index and the generation of that slot.
+		 * Resolving a handle takes constant time. Once the object is destroyed its slot moves on to the next generation,
+		 * so old handles resolve to nullptr instead of dangling, even if the slot has been reused by a new object.
+		 *
+		 * GameObject, Transform and Component hand out handles through getHandle().
+		 */
+		template <typename T>
+		struct Handle
+		{
+			static const uint32_t invalidIndex = UINT32_MAX;
+
+			uint32_t index = invalidIndex;
+			uint32_t generation = 0;
+
+			/**
+			 * Returns the object this handle refers to, nullptr if the object no longer exists or if the handle is empty.
+			 */
+			T* get() const { return HandleTable<T>::resolve(*this); }
+
+			/**
+			 * Returns true if the object this handle refers to still exists
+			 */
+			explicit operator bool() const { return get() != nullptr; }
+
+			bool operator==(Handle const& other) const { return index == other.index && generation == other.generation; }
+			bool operator!=(Handle const& other) const { return !(*this == other); }
+		};
+
+		/**
+		 * HandleTable is the slot map that backs the handles of type T.
+		 * Free slots are reused in LIFO order. Every reuse bumps the slot's generation.
+		 *
+		 * Handles are created and destroyed along with their objects, which happens on the main thread.
+		 * Resolving handles from jobs is safe as long as no objects are created or destroyed while the jobs run.
+		 */
+		template <typename T>
+		class HandleTable final
+		{
+		public:
+			/**
+			 * Assigns a slot to the given object and returns a handle to it
+			 */
+			static Handle<T> create(T* object);
+			/**
+			 * Frees the slot of the given handle, every handle to it will resolve to nullptr from now on
+			 */
+			static void destroy(Handle<T> handle);
+			/**
+			 * Returns the object the handle refers to, or nullptr if the handle is outdated or empty
+			 */
+			static T* resolve(Handle<T> handle)
+			{
+				if (handle.index >= slots.size())
+					return nullptr;
+				Slot const& slot = slots[handle.index];
+				return slot.generation == handle.generation ? slot.object : nullptr;
+			}
+		private:
+			struct Slot
+			{
+				T* object;
+				uint32_t generation;
+				/**
+				 * The next free slot, only used while this slot is free
+				 */
+				uint32_t nextFree;
+			};
+
+			static std::vector<Slot> slots;
+			static uint32_t firstFree;
+		};
+
+		template <typename T>
+		std::vector<typename HandleTable<T>::Slot> HandleTable<T>::slots;
+
+		template <typename T>
+		uint32_t HandleTable<T>::firstFree = Handle<T>::invalidIndex;
+
+		template <typename T>
+		Handle<T> HandleTable<T>::create(T* object)
+		{
+			Handle<T> handle;
+			if (firstFree != Handle<T>::invalidIndex)
+			{
+				handle.index = firstFree;
+				firstFree = slots[firstFree].nextFree;
+			}
+			else
+			{
+				handle.index = uint32_t(slots.size());
+				slots.push_back({ nullptr, 1, Handle<T>::invalidIndex });
+			}
+
+			Slot& slot = slots[handle.index];
+			slot.object = object;
+			handle.generation = slot.generation;
+			return handle;
+		}
+
+		template <typename T>
+		void HandleTable<T>::destroy(Handle<T> handle)
+		{
+			if (resolve(handle) == nullptr)
+				return;
+
+			Slot& slot = slots[handle.index];
+			slot.object = nullptr;
+			//Generation 0 is reserved for empty handles
+			slot.generation = slot.generation == UINT32_MAX ? 1 : slot.generation + 1;
+			slot.nextFree = firstFree;
+			firstFree = handle.index;
+		}
+	}
+}
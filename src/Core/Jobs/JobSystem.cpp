@@ -0,0 +1,223 @@
+﻿#include "JobSystem.h"
+#include "Core/UserPrefs.h"
+#include "Misc/Profiler.h"
+#include <algorithm>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Jobs
+		{
+			JobSystem* JobSystem::instance = nullptr;
+
+			/**
+			 * The index of the queue owned by the current thread. -1 if the thread isn't owned by the JobSystem.
+			 */
+			static thread_local int queueIndex = -1;
+
+			JobSystem::JobSystem() : queuedJobs(0), running(true)
+			{
+				int const workerPref = UserPrefs::getIntValue("JOBWORKERS");
+				unsigned int const workerCount = workerPref > 0 ? unsigned(workerPref) : std::max(std::thread::hardware_concurrency(), 1u) - 1;
+
+				//Queue 0 belongs to the thread that creates the system (the main thread)
+				queueIndex = 0;
+				for (unsigned int i = 0; i <= workerCount; i++)
+					queues.push_back(std::make_unique<WorkerQueue>());
+
+				instance = this;
+				for (unsigned int i = 1; i <= workerCount; i++)
+					workers.push_back(std::thread(&JobSystem::workerLoop, this, i));
+			}
+
+			JobSystem::~JobSystem()
+			{
+				//Help finish whatever is still queued before shutting down
+				Job job;
+				while (tryGetJob(job))
+					execute(job);
+
+				{
+					std::lock_guard<std::mutex> lock(sleepMutex);
+					running = false;
+				}
+				sleepCondition.notify_all();
+
+				for (std::thread& worker : workers)
+					worker.join();
+
+				instance = nullptr;
+				queueIndex = -1;
+			}
+
+			JobHandle JobSystem::schedule(std::function<void()> function, JobHandle dependency)
+			{
+				JobHandle handle = std::make_shared<JobCounter>(1);
+				Job job = { std::move(function), handle };
+
+				if (instance == nullptr)
+				{
+					//No job system, run on the calling thread
+					job.function();
+					handle->pending = 0;
+					return handle;
+				}
+
+				instance->submit(std::move(job), dependency);
+				return handle;
+			}
+
+			JobHandle JobSystem::scheduleParallelFor(size_t count, size_t batchSize, std::function<void(size_t, size_t)> function, JobHandle dependency)
+			{
+				batchSize = std::max<size_t>(batchSize, 1);
+				size_t const batches = (count + batchSize - 1) / batchSize;
+				JobHandle handle = std::make_shared<JobCounter>(int(batches));
+
+				if (instance == nullptr)
+				{
+					if (count != 0)
+						function(0, count);
+					handle->pending = 0;
+					return handle;
+				}
+
+				for (size_t i = 0; i < batches; i++)
+				{
+					size_t const begin = i * batchSize;
+					size_t const end = std::min(begin + batchSize, count);
+					Job job = { [function, begin, end]() { function(begin, end); }, handle };
+					instance->submit(std::move(job), dependency);
+				}
+				return handle;
+			}
+
+			void JobSystem::parallelFor(size_t count, size_t batchSize, std::function<void(size_t, size_t)> function)
+			{
+				wait(scheduleParallelFor(count, batchSize, std::move(function)));
+			}
+
+			void JobSystem::wait(JobHandle const& handle)
+			{
+				if (handle == nullptr)
+					return;
+
+				while (!handle->isDone())
+				{
+					//Execute other work instead of idling, this also prevents deadlocks when waiting from within a job
+					Job job;
+					if (instance != nullptr && instance->tryGetJob(job))
+						instance->execute(job);
+					else
+						std::this_thread::yield();
+				}
+			}
+
+			unsigned int JobSystem::getThreadCount()
+			{
+				return instance != nullptr ? unsigned(instance->queues.size()) : 1;
+			}
+
+			void JobSystem::submit(Job job, JobHandle const& dependency)
+			{
+				if (dependency != nullptr)
+				{
+					std::lock_guard<std::mutex> lock(dependency->mutex);
+					if (!dependency->isDone())
+					{
+						dependency->continuations.push_back(std::move(job));
+						return;
+					}
+				}
+				push(std::move(job));
+			}
+
+			void JobSystem::push(Job job)
+			{
+				WorkerQueue& queue = *queues[queueIndex >= 0 ? queueIndex : 0];
+				{
+					std::lock_guard<std::mutex> lock(queue.mutex);
+					queue.jobs.push_back(std::move(job));
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(sleepMutex);
+					++queuedJobs;
+				}
+				sleepCondition.notify_one();
+			}
+
+			bool JobSystem::tryGetJob(Job& job)
+			{
+				int const own = queueIndex >= 0 ? queueIndex : 0;
+
+				//Own queue first, newest job first since its data is most likely still in cache
+				{
+					WorkerQueue& queue = *queues[own];
+					std::lock_guard<std::mutex> lock(queue.mutex);
+					if (!queue.jobs.empty())
+					{
+						job = std::move(queue.jobs.back());
+						queue.jobs.pop_back();
+						--queuedJobs;
+						return true;
+					}
+				}
+
+				//Steal the oldest job of another queue
+				for (size_t i = 1; i < queues.size(); i++)
+				{
+					WorkerQueue& queue = *queues[(own + i) % queues.size()];
+					std::lock_guard<std::mutex> lock(queue.mutex);
+					if (!queue.jobs.empty())
+					{
+						job = std::move(queue.jobs.front());
+						queue.jobs.pop_front();
+						--queuedJobs;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			void JobSystem::execute(Job& job)
+			{
+				job.function();
+
+				JobCounter& counter = *job.counter;
+				if (counter.pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+					return;
+
+				//The group is done, schedule everything that was waiting on it
+				std::vector<Job> continuations;
+				{
+					std::lock_guard<std::mutex> lock(counter.mutex);
+					continuations.swap(counter.continuations);
+				}
+				for (Job& continuation : continuations)
+					push(std::move(continuation));
+			}
+
+			void JobSystem::workerLoop(unsigned int index)
+			{
+				queueIndex = int(index);
+				TRISTEON_PROFILE_THREAD("Job worker " + std::to_string(index));
+
+				while (true)
+				{
+					Job job;
+					if (tryGetJob(job))
+					{
+						execute(job);
+						continue;
+					}
+
+					std::unique_lock<std::mutex> lock(sleepMutex);
+					sleepCondition.wait(lock, [&] { return queuedJobs > 0 || !running; });
+					if (!running && queuedJobs == 0)
+						return;
+				}
+			}
+		}
+	}
+}
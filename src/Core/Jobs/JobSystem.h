@@ -0,0 +1,157 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <XPlatform/access.h>
+
+TRISTEON_UNIQUE_ACCESS_DECL()
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		class Engine;
+
+		namespace Jobs
+		{
+			class JobCounter;
+
+			/**
+			 * A handle to a scheduled job (or group of jobs). Can be waited on and used as a dependency for other jobs.
+			 */
+			typedef std::shared_ptr<JobCounter> JobHandle;
+
+			/**
+			 * Job describes a single piece of work, and the counter that gets decremented once it has been executed.
+			 */
+			struct Job
+			{
+				std::function<void()> function;
+				JobHandle counter;
+			};
+
+			/**
+			 * JobCounter keeps track of the amount of unfinished jobs in a group.
+			 * Jobs that depend on the group are stored as continuations, and get scheduled once the counter reaches zero.
+			 */
+			class JobCounter final
+			{
+				friend class JobSystem;
+			public:
+				explicit JobCounter(int pending) : pending(pending) { }
+
+				/**
+				 * Returns true if every job in the group has finished executing
+				 */
+				bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+			private:
+				std::atomic<int> pending;
+				std::mutex mutex;
+				std::vector<Job> continuations;
+			};
+
+			/**
+			 * JobSystem is a work-stealing scheduler that executes jobs on a worker thread per hardware core.
+			 * Every worker owns a queue. Workers pop their own most recent jobs first and steal the oldest jobs of other workers when they run out.
+			 * Threads that wait on a job help executing other jobs instead of blocking.
+			 *
+			 * Engine subsystems and gameplay code can submit work through the static functions.
+			 * If no JobSystem has been created (e.g. in tools), jobs are executed immediately on the calling thread.
+			 *
+			 * Jobs are expected not to throw, an exception escaping a job terminates the program.
+			 */
+			class JobSystem final
+			{
+				TRISTEON_UNIQUE_ACCESS(JobSystem)
+			public:
+				/**
+				 * Schedules the given function to be executed on a worker thread.
+				 * \param dependency Optional. The job will not start until the dependency has finished.
+				 * \return A handle that can be waited on or used as a dependency.
+				 */
+				static JobHandle schedule(std::function<void()> function, JobHandle dependency = nullptr);
+
+				/**
+				 * Splits [0, count) into batches of batchSize and schedules function(begin, end) for every batch.
+				 * \param dependency Optional. None of the batches will start until the dependency has finished.
+				 * \return A single handle that finishes once every batch has been executed.
+				 */
+				static JobHandle scheduleParallelFor(size_t count, size_t batchSize, std::function<void(size_t, size_t)> function, JobHandle dependency = nullptr);
+
+				/**
+				 * Executes function(begin, end) over [0, count) in batches of batchSize across the workers, and waits until all batches are done.
+				 * The calling thread participates in the work.
+				 */
+				static void parallelFor(size_t count, size_t batchSize, std::function<void(size_t, size_t)> function);
+
+				/**
+				 * Blocks until the given job has finished. The calling thread executes other jobs while it waits.
+				 */
+				static void wait(JobHandle const& handle);
+
+				/**
+				 * Returns the amount of threads that execute jobs, including the main thread.
+				 */
+				static unsigned int getThreadCount();
+			private:
+				/**
+				 * Creates a worker thread for each hardware thread except the main thread.
+				 * The amount of workers can be overriden through the JOBWORKERS user pref, 0 or less uses the default.
+				 */
+				JobSystem();
+				/**
+				 * Finishes all the remaining jobs and joins the worker threads
+				 */
+				~JobSystem();
+
+				/**
+				 * The queue of a single thread. The owner pushes/pops at the back, thieves steal from the front.
+				 */
+				struct WorkerQueue
+				{
+					std::mutex mutex;
+					std::deque<Job> jobs;
+				};
+
+				/**
+				 * Pushes the job to the queue of the calling thread, or to the main queue if the caller isn't one of our threads.
+				 */
+				void push(Job job);
+				/**
+				 * Schedules the job now if its dependency is done, otherwise stores it as a continuation of the dependency.
+				 */
+				void submit(Job job, JobHandle const& dependency);
+				/**
+				 * Pops a job from our own queue, or steals one from another queue. Returns false if no job was found.
+				 */
+				bool tryGetJob(Job& job);
+				/**
+				 * Executes the job, decrements its counter and schedules the continuations of the counter once it reaches zero.
+				 */
+				void execute(Job& job);
+				/**
+				 * The main loop of a worker thread
+				 */
+				void workerLoop(unsigned int index);
+
+				std::vector<std::unique_ptr<WorkerQueue>> queues;
+				std::vector<std::thread> workers;
+
+				/**
+				 * The amount of jobs in all the queues, used to put idle workers to sleep
+				 */
+				std::atomic<int> queuedJobs;
+				std::atomic<bool> running;
+				std::mutex sleepMutex;
+				std::condition_variable sleepCondition;
+
+				static JobSystem* instance;
+			};
+		}
+	}
+}
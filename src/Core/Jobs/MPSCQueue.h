@@ -0,0 +1,133 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Jobs
+		{
+			/**
+			 * MPSCQueue is a bounded, lock-free multi-producer/single-consumer ring buffer.
+			 * Any thread can push, only a single thread (the owner) may pop.
+			 *
+			 * Every cell carries a sequence number that tells producers and the consumer whose turn it is.
+			 * Producers claim a position with a compare-exchange, write the value and then publish it by bumping the cell's sequence.
+			 * The consumer only reads cells that have been published, so a slow producer never exposes a half written value.
+			 *
+			 * \tparam Capacity The maximum amount of queued values, must be a power of two.
+			 */
+			template <typename T, size_t Capacity>
+			class MPSCQueue final
+			{
+				static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MPSCQueue capacity must be a power of two!");
+			public:
+				MPSCQueue();
+				~MPSCQueue();
+
+				MPSCQueue(MPSCQueue const&) = delete;
+				MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+				/**
+				 * Adds a value to the back of the queue. Safe to call from any thread.
+				 * \return False if the queue is full, in which case the value is not added.
+				 */
+				bool push(T const& value);
+
+				/**
+				 * Removes the value at the front of the queue and stores it in value. Must only be called by the consumer thread.
+				 * \return False if the queue is empty.
+				 */
+				bool pop(T& value);
+			private:
+				struct Cell
+				{
+					std::atomic<size_t> sequence;
+					typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+				};
+
+				static const size_t mask = Capacity - 1;
+
+				std::array<Cell, Capacity> cells;
+				//Producers and the consumer write different positions, keep them on separate cache lines
+				alignas(64) std::atomic<size_t> pushPosition;
+				alignas(64) size_t popPosition;
+			};
+
+			template <typename T, size_t Capacity>
+			MPSCQueue<T, Capacity>::MPSCQueue() : pushPosition(0), popPosition(0)
+			{
+				//A cell is free for the producer that claims position i when its sequence equals i
+				for (size_t i = 0; i < Capacity; i++)
+					cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+
+			template <typename T, size_t Capacity>
+			MPSCQueue<T, Capacity>::~MPSCQueue()
+			{
+				//Destroy the values that were never popped
+				while (cells[popPosition & mask].sequence.load(std::memory_order_acquire) == popPosition + 1)
+				{
+					reinterpret_cast<T*>(&cells[popPosition & mask].storage)->~T();
+					popPosition++;
+				}
+			}
+
+			template <typename T, size_t Capacity>
+			bool MPSCQueue<T, Capacity>::push(T const& value)
+			{
+				size_t position = pushPosition.load(std::memory_order_relaxed);
+				while (true)
+				{
+					Cell& cell = cells[position & mask];
+					size_t const sequence = cell.sequence.load(std::memory_order_acquire);
+					intptr_t const difference = intptr_t(sequence) - intptr_t(position);
+
+					if (difference == 0)
+					{
+						//The cell is free, try to claim the position. On failure position is reloaded and we try again.
+						if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						{
+							new (&cell.storage) T(value);
+							cell.sequence.store(position + 1, std::memory_order_release);
+							return true;
+						}
+					}
+					else if (difference < 0)
+					{
+						//The consumer hasn't freed this cell yet, the queue is full
+						return false;
+					}
+					else
+					{
+						//Another producer claimed the position before us
+						position = pushPosition.load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			template <typename T, size_t Capacity>
+			bool MPSCQueue<T, Capacity>::pop(T& value)
+			{
+				Cell& cell = cells[popPosition & mask];
+				if (cell.sequence.load(std::memory_order_acquire) != popPosition + 1)
+					return false;
+
+				T* const stored = reinterpret_cast<T*>(&cell.storage);
+				value = std::move(*stored);
+				stored->~T();
+
+				//Hand the cell back to producers for the next lap around the ring
+				cell.sequence.store(popPosition + Capacity, std::memory_order_release);
+				popPosition++;
+				return true;
+			}
+		}
+	}
+}
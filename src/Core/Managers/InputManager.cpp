@@ -14,7 +14,7 @@ namespace Tristeon
 		{
 			InputManager::InputManager(GLFWwindow* window)
 			{
-				MessageBus::subscribeToMessage(MT_AFTERFRAME, [&](Message msg) { resetInput(); });
+				afterFrame = MessageBus::subscribeToMessage(MT_AFTERFRAME, [&](Message msg) { resetInput(); });
 				Misc::Mouse::window = window;
 				glfwSetKeyCallback(window, [](GLFWwindow* window, int key, int scancode, int action, int mods) { Misc::Keyboard::keyCallback(key, scancode, action, mods); });
 				glfwSetMouseButtonCallback(window, [](GLFWwindow* window, int button, int action, int mods) { Misc::Mouse::buttonCallback(button, action, mods); });
@@ -23,6 +23,11 @@ namespace Tristeon
 				glfwSetScrollCallback(window, [](GLFWwindow* window, double x, double y) { Misc::Mouse::scrollCallback(x, y); });
 			}
 
+			InputManager::~InputManager()
+			{
+				MessageBus::unsubscribeFromMessage(afterFrame);
+			}
+
 			void InputManager::resetInput() const
 			{
 				Misc::Keyboard::reset();
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <XPlatform/access.h>
+#include "Core/MessageBus.h"
 
 struct GLFWwindow;
 
@@ -25,10 +26,13 @@ namespace Tristeon
 				 * \param window The GLFW window, used to subscribe to callbacks 
 				 */
 				explicit InputManager(GLFWwindow* window);
+				~InputManager();
 				/**
 				 * Resets keydown and keyup, called every frame
 				 */
 				void resetInput() const;
+
+				MessageBus::Subscription afterFrame;
 			};
 		}
 	}
@@ -38,6 +38,11 @@ namespace Tristeon
 			MT_WINDOW_RESIZE,
 
 			MT_SHARE_DATA,
+
+			/**
+			 * The amount of message types. Not a message, new types must be added above this.
+			 */
+			MT_COUNT
 		};
 
 		/**
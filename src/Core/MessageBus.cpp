@@ -1,29 +1,63 @@
 ﻿#include "MessageBus.h"
-#include "UserPrefs.h"
-#include "Message.h"
+#include "Misc/Profiler.h"
 
 namespace Tristeon
 {
 	namespace Core
 	{
-		std::map<MessageType, Misc::Delegate<Message>> MessageBus::messageCallbacks;
+		std::array<Misc::Delegate<Message const&>, MT_COUNT> MessageBus::subscribers;
+		Jobs::MPSCQueue<Message, MessageBus::postedMessageCapacity> MessageBus::postedMessages;
 
-		void MessageBus::sendMessage(Message message)
+#ifdef TRISTEON_PROFILER
+		/**
+		 * The profiler zone names of the message types, in the order of MessageType
+		 */
+		static const char* const messageZones[] =
 		{
-			validateMessageType(message.type);
-			messageCallbacks[message.type].invoke(message);
+			"MT_START", "MT_UPDATE", "MT_LATEUPDATE", "MT_FIXEDUPDATE", "MT_PRERENDER", "MT_RENDER", "MT_POSTRENDER", "MT_AFTERFRAME", "MT_QUIT",
+			"MT_MANAGER_RESET",
+			"MT_RENDERINGCOMPONENT_REGISTER", "MT_SCRIPTINGCOMPONENT_REGISTER",
+			"MT_CAMERA_REGISTER", "MT_CAMERA_DEREGISTER",
+			"MT_RENDERINGCOMPONENT_DEREGISTER", "MT_SCRIPTINGCOMPONENT_DEREGISTER",
+			"MT_GAME_LOGIC_START", "MT_GAME_LOGIC_STOP",
+			"MT_WINDOW_RESIZE",
+			"MT_SHARE_DATA"
+		};
+		static_assert(sizeof(messageZones) / sizeof(messageZones[0]) == MT_COUNT, "Every message type needs a profiler zone name");
+#endif
+
+		void MessageBus::sendMessage(Message const& message)
+		{
+			TRISTEON_PROFILE_SCOPE(messageZones[message.type]);
+			subscribers[message.type].invoke(message);
+		}
+
+		bool MessageBus::postMessage(Message const& message)
+		{
+			return postedMessages.push(message);
+		}
+
+		void MessageBus::dispatchPostedMessages()
+		{
+			TRISTEON_PROFILE_FUNCTION();
+			//Bounded so that producers that keep posting can't stall the frame, the rest is sent next frame
+			Message message(MT_COUNT);
+			for (size_t i = 0; i < postedMessageCapacity && postedMessages.pop(message); i++)
+				sendMessage(message);
 		}
 
-		void MessageBus::subscribeToMessage(MessageType type, std::function<void(Message)> f)
+		MessageBus::Subscription MessageBus::subscribeToMessage(MessageType type, Callback f)
 		{
-			validateMessageType(type);
-			messageCallbacks[type] += f;
+			Subscription subscription;
+			subscription.type = type;
+			subscription.subscription = subscribers[type] += std::move(f);
+			return subscription;
 		}
 
-		void MessageBus::validateMessageType(MessageType type)
+		void MessageBus::unsubscribeFromMessage(Subscription const& subscription)
 		{
-			if (!messageCallbacks.count(type))
-				messageCallbacks[type] = Misc::Delegate<Message>();
+			if (subscription.type < MT_COUNT)
+				subscribers[subscription.type] -= subscription.subscription;
 		}
 	}
 }
\ No newline at end of file
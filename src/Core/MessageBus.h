@@ -1,6 +1,9 @@
 ﻿#pragma once
-#include <map>
+#include <array>
+#include <functional>
+#include <vector>
 #include "Message.h"
+#include "Jobs/MPSCQueue.h"
 #include "Misc/Delegate.h"
 
 namespace Tristeon
@@ -10,28 +13,69 @@ namespace Tristeon
 		/**
 		 * The MessageBus is an abstract message bus that allows for subsystems to communicate information back/forth
 		 * without knowledge of the existence one another.
+		 *
+		 * Subscribers are stored in a flat array indexed by MessageType, sending a message doesn't do any lookups or allocations.
+		 *
+		 * sendMessage and subscribeToMessage are main thread only. Other threads can use postMessage,
+		 * posted messages are sent on the main thread at the start of the next frame.
+		 *
+		 * Subscribers should keep the token returned by subscribeToMessage and unsubscribe once the objects they capture are destroyed.
 		 */
 		class MessageBus final
 		{
 		public:
+			/**
+			 * The signature of message callbacks
+			 */
+			typedef std::function<void(Message const&)> Callback;
+
+			/**
+			 * The token that is returned by subscribeToMessage, used to unsubscribe the function again
+			 */
+			struct Subscription
+			{
+				MessageType type = MT_COUNT;
+				Misc::Subscription subscription;
+			};
+
 			/**
 			 * Sends a message to all listeners subscribed to message.type
 			 */
-			static void sendMessage(Message message);
+			static void sendMessage(Message const& message);
+
+			/**
+			 * Queues a message to be sent on the main thread at the start of the next frame. Safe to call from any thread.
+			 * The userData of the message must stay valid until it has been sent.
+			 * \return False if the queue is full, in which case the message is dropped.
+			 */
+			static bool postMessage(Message const& message);
+
+			/**
+			 * Sends the messages that have been posted, in the order they were posted. Called by the engine on the main thread once per frame.
+			 */
+			static void dispatchPostedMessages();
 
 			/**
 			 * Adds a function to the message callbacks based on the given message type
 			 * \param type The type of message the given function should listen to
+			 * \return The token that can be passed to unsubscribeFromMessage
 			 */
-			static void subscribeToMessage(MessageType type, std::function<void(Message)> f);
+			static Subscription subscribeToMessage(MessageType type, Callback f);
 
-		private:
 			/**
-			 * Validates if the given messagetype has already been added to the callback system. If not, the type will be added.
+			 * Removes the function that belongs to the given token from the message callbacks. Ignored if it has already been removed.
+			 * Safe to call from within a message callback, the function won't be called anymore from that point on.
 			 */
-			static void validateMessageType(MessageType type);
+			static void unsubscribeFromMessage(Subscription const& subscription);
 
-			static std::map<MessageType, Misc::Delegate<Message>> messageCallbacks;
+		private:
+			static std::array<Misc::Delegate<Message const&>, MT_COUNT> subscribers;
+
+			/**
+			 * The maximum amount of messages that can be posted in between two dispatches
+			 */
+			static const size_t postedMessageCapacity = 4096;
+			static Jobs::MPSCQueue<Message, postedMessageCapacity> postedMessages;
 		};
 	}
 }
\ No newline at end of file
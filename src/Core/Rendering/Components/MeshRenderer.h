@@ -10,11 +10,14 @@ namespace Tristeon
 	{
 		namespace Rendering
 		{
+			namespace Vulkan { class InternalMeshRenderer; }
+
 			/**
 			 * \brief The MeshRenderer component renders meshes
 			 */
 			class MeshRenderer : public Renderer
 			{
+				friend Vulkan::InternalMeshRenderer;
 			public:
 				/**
 				* \brief The Mesh of the meshrenderer
@@ -1,6 +1,7 @@
 ﻿#include "DebugDrawManager.h"
 #include <cmath>
-#include <glm/gtc/constants.inl>
+#include <glm/gtc/constants.hpp>
+#include "Math/Simd.h"
 
 namespace Tristeon
 {
@@ -12,44 +13,54 @@ namespace Tristeon
 
 			void DebugDrawManager::addLine(const Math::Vector3& from, const Math::Vector3& to, float width, const Misc::Color& color)
 			{
+				//There's nothing to draw to when running headless
+				if (instance == nullptr)
+					return;
 				instance->drawList.push(Line(Data::Vertex(from), Data::Vertex(to), width, color));
 			}
 
 			void DebugDrawManager::addCube(const Math::Vector3& min, const Math::Vector3& max, float lineWidth, const Misc::Color& color)
 			{
-				//Rect coords 1
-				Math::Vector3 const bl1 = min;
-				Math::Vector3 const tl1 = Math::Vector3(min.x, max.y, min.z);
-				Math::Vector3 const br1 = Math::Vector3(max.x, min.y, min.z);
-				Math::Vector3 const tr1 = Math::Vector3(max.x, max.y, min.z);
+				glm::vec3 corners[8];
+				getCorners(min, max, corners);
+				addCube(corners, lineWidth, color);
+			}
 
-				//Rect coords 2
-				Math::Vector3 const bl2 = Math::Vector3(min.x, min.y, max.z);
-				Math::Vector3 const tl2 = Math::Vector3(min.x, max.y, max.z);
-				Math::Vector3 const br2 = Math::Vector3(max.x, min.y, max.z);
-				Math::Vector3 const tr2 = max;
+			void DebugDrawManager::addCube(const Math::Vector3& min, const Math::Vector3& max, const glm::mat4& transform, float lineWidth, const Misc::Color& color)
+			{
+				glm::vec3 corners[8];
+				getCorners(min, max, corners);
+				Math::Simd::transformPoints(transform, corners, corners, 8);
+				addCube(corners, lineWidth, color);
+			}
 
-				//Rect 1
-				instance->drawList.push(Line(bl1, tl1, lineWidth, color));
-				instance->drawList.push(Line(tl1, tr1, lineWidth, color));
-				instance->drawList.push(Line(tr1, br1, lineWidth, color));
-				instance->drawList.push(Line(br1, bl1, lineWidth, color));
+			void DebugDrawManager::getCorners(const Math::Vector3& min, const Math::Vector3& max, glm::vec3 corners[8])
+			{
+				for (int i = 0; i < 8; i++)
+					corners[i] = glm::vec3(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z);
+			}
 
-				//Rect 2
-				instance->drawList.push(Line(bl2, tl2, lineWidth, color));
-				instance->drawList.push(Line(tl2, tr2, lineWidth, color));
-				instance->drawList.push(Line(tr2, br2, lineWidth, color));
-				instance->drawList.push(Line(br2, bl2, lineWidth, color));
+			void DebugDrawManager::addCube(const glm::vec3 corners[8], float lineWidth, const Misc::Color& color)
+			{
+				if (instance == nullptr)
+					return;
 
-				//Connecting corners
-				instance->drawList.push(Line(bl1, bl2, lineWidth, color));
-				instance->drawList.push(Line(tl1, tl2, lineWidth, color));
-				instance->drawList.push(Line(tr1, tr2, lineWidth, color));
-				instance->drawList.push(Line(br1, br2, lineWidth, color));
+				//Every edge connects two corners that differ in a single axis
+				for (int i = 0; i < 8; i++)
+				{
+					for (int axis = 1; axis < 8; axis <<= 1)
+					{
+						if ((i & axis) == 0)
+							instance->drawList.push(Line(Data::Vertex(Math::Vector3(corners[i])), Data::Vertex(Math::Vector3(corners[i | axis])), lineWidth, color));
+					}
+				}
 			}
 
 			void DebugDrawManager::addSphere(const Math::Vector3& center, float r, float lineWidth, const Misc::Color& color, int circles, int resolution)
 			{
+				if (instance == nullptr)
+					return;
+
 				float const PI = 3.14159265f;
 				std::vector<Math::Vector3> positions;
 
@@ -2,6 +2,7 @@
 #include "Data/Mesh.h"
 #include "Misc/Color.h"
 #include <queue>
+#include <glm/mat4x4.hpp>
 
 namespace Tristeon
 {
@@ -34,6 +35,15 @@ namespace Tristeon
 				 * \param color The color of the cube
 				 */
 				static void addCube(const Math::Vector3& min, const Math::Vector3& max, float lineWidth, const Misc::Color& color);
+				/**
+				 * \brief Adds an oriented cube to the drawlist
+				 * \param min The smallest point of the cube, in local space
+				 * \param max The biggest point of the cube, in local space
+				 * \param transform The matrix that transforms the cube from local space to world space
+				 * \param lineWidth The width of the lines
+				 * \param color The color of the cube
+				 */
+				static void addCube(const Math::Vector3& min, const Math::Vector3& max, const glm::mat4& transform, float lineWidth, const Misc::Color& color);
 				/**
 				 * \brief Adds a sphere to the drawlist
 				 * \param center The center position of the sphere
@@ -49,7 +59,7 @@ namespace Tristeon
 				 * \brief The deconstructor of DebugDrawManager, has to be virtual to allow for correct destruction
 				 */
 				virtual ~DebugDrawManager() = default;
-			protected:
+
 				/**
 				 * \brief The line struct describes a single renderable line, with its respective properties
 				 */
@@ -81,6 +91,15 @@ namespace Tristeon
 					 */
 					Line(Data::Vertex start, Data::Vertex end, float width, Misc::Color color) : start(start), end(end), width(width), color(color) { /*Empty*/ }
 				};
+			protected:
+				/**
+				 * \brief Fills corners with the 8 corners of the box. Bit 0, 1 and 2 of the index select max over min for x, y and z respectively
+				 */
+				static void getCorners(const Math::Vector3& min, const Math::Vector3& max, glm::vec3 corners[8]);
+				/**
+				 * \brief Adds the 12 edges of a cube to the drawlist, the corners are expected to be ordered like getCorners()
+				 */
+				static void addCube(const glm::vec3 corners[8], float lineWidth, const Misc::Color& color);
 
 				/**
 				 * \brief The instance of the debug draw manager, used to allow static functions like addLine
@@ -88,7 +107,7 @@ namespace Tristeon
 				static DebugDrawManager* instance;
 				
 				/**
-				 * \brief The drawlist, resets every frame
+				 * \brief The drawlist, filled during the frame and handed over to the render manager once the frame is captured
 				 */
 				std::queue<Line> drawList;
 				/**
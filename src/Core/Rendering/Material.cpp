@@ -1,7 +1,11 @@
 #include "Material.h"
+#include "RenderThread.h"
 #include "Editor/JsonSerializer.h"
 #include "XPlatform/typename.h"
 
+#include <cstring>
+#include <glm/glm.hpp>
+
 #include <boost/filesystem.hpp>
 namespace filesystem = boost::filesystem;
 
@@ -27,6 +31,9 @@ namespace Tristeon
 
 			void Material::deserialize(nlohmann::json json)
 			{
+				//The render thread might be reading our properties
+				RenderThread::sync();
+
 				//Get the shader file
 				const std::string shaderFilePathValue = json["shaderFilePath"];
 				//Only update our shader if our path has changed
@@ -77,6 +84,7 @@ namespace Tristeon
 
 			void Material::setTexture(std::string name, std::string path)
 			{
+				RenderThread::sync();
 				//Validate if the property exists
 				if (texturePaths.find(name) != texturePaths.end())
 					texturePaths[name] = path;
@@ -86,6 +94,7 @@ namespace Tristeon
 
 			void Material::setFloat(std::string name, float value)
 			{
+				RenderThread::sync();
 				//Validate if the property exists
 				if (floats.find(name) != floats.end())
 					floats[name] = value;
@@ -95,6 +104,7 @@ namespace Tristeon
 
 			void Material::setVector3(std::string name, Math::Vector3 value)
 			{
+				RenderThread::sync();
 				//Validate if the property exists
 				if (vectors.find(name) != vectors.end())
 					vectors[name] = value;
@@ -104,6 +114,7 @@ namespace Tristeon
 
 			void Material::setColor(std::string name, Misc::Color value)
 			{
+				RenderThread::sync();
 				//Validate if the property exists
 				if (colors.find(name) != colors.end())
 					colors[name] = value;
@@ -111,6 +122,67 @@ namespace Tristeon
 					Misc::Console::warning("Trying to set material color [" + name + "] but that variable is not defined in shader.properties!");
 			}
 
+			bool Material::packProperty(ShaderProperty const& property, uint8_t* destination)
+			{
+				switch (property.valueType)
+				{
+				case DT_Color:
+				{
+					//Color and Vector3 have the same layout as their glm counterparts, so they can be copied directly
+					Misc::Color const c = colors[property.name];
+					memcpy(destination, &c, sizeof(glm::vec4));
+					return true;
+				}
+				case DT_Float:
+				{
+					float f = floats[property.name];
+					memcpy(destination, &f, sizeof(float));
+					return true;
+				}
+				case DT_Vector3:
+				{
+					Math::Vector3 const vec = vectors[property.name];
+					memcpy(destination, &vec, sizeof(glm::vec3));
+					return true;
+				}
+				case DT_Struct:
+				{
+					//Fill the memory with the children, one after another
+					uint8_t* ptr = destination;
+					for (auto const& c : property.children)
+					{
+						switch (c.valueType)
+						{
+						case DT_Float:
+						{
+							float f = floats[property.name + "." + c.name];
+							memcpy(ptr, &f, sizeof(float));
+							ptr += sizeof(float);
+							break;
+						}
+						case DT_Color:
+						{
+							const auto col = colors[property.name + "." + c.name];
+							memcpy(ptr, &col, sizeof(glm::vec4));
+							ptr += sizeof(glm::vec4);
+							break;
+						}
+						case DT_Vector3:
+						{
+							Math::Vector3 const vec = vectors[property.name + "." + c.name];
+							memcpy(ptr, &vec, sizeof(glm::vec3));
+							ptr += sizeof(glm::vec3);
+							break;
+						}
+						}
+					}
+					return true;
+				}
+				default:
+					return false;
+				}
+			}
+
 			void Material::updateShader()
 			{
 				//Try to set it if possible
@@ -74,6 +74,14 @@ namespace Tristeon
 				 * \param value The new value of the vector3 property
 				 */
 				virtual void setColor(std::string name, Misc::Color value);
+
+				/**
+				 * \brief Writes the value of the given property into destination, in the layout that the shader expects
+				 * \param property A color, float, vector3 or struct property of the shader
+				 * \param destination The memory that the value is written to, it has to hold at least property.size bytes
+				 * \return False if the property type can't be packed, destination isn't modified in that case
+				 */
+				bool packProperty(ShaderProperty const& property, uint8_t* destination);
 			protected:
 				/**
 				 * \brief Initializes the material. Can be overriden by API specific behavior
@@ -5,6 +5,8 @@
 #include <Core/Components/Camera.h>
 #include <Core/Rendering/Components/Renderer.h>
 #include <Misc/Console.h>
+#include "Misc/Profiler.h"
+#include "Core/UserPrefs.h"
 
 #include <boost/filesystem.hpp>
 #include "Core/BindingData.h"
@@ -24,19 +26,47 @@ namespace Tristeon
 				instance = this;
 
 				//Render
-				MessageBus::subscribeToMessage(MT_RENDER, [&](Message msg) { render(); });
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_RENDER, [&](Message msg) { render(); }));
 
 				//(De)registering of render components
-				MessageBus::subscribeToMessage(MT_RENDERINGCOMPONENT_REGISTER, [&](Message msg) { registerRenderer(msg); });
-				MessageBus::subscribeToMessage(MT_RENDERINGCOMPONENT_DEREGISTER, [&](Message msg) { deregisterRenderer(msg); });
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_RENDERINGCOMPONENT_REGISTER, [&](Message msg) { registerRenderer(msg); }));
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_RENDERINGCOMPONENT_DEREGISTER, [&](Message msg) { deregisterRenderer(msg); }));
 
 				//(De)registering of cameras
-				MessageBus::subscribeToMessage(MT_CAMERA_REGISTER, [&](Message msg) { registerCamera(msg); });
-				MessageBus::subscribeToMessage(MT_CAMERA_DEREGISTER, [&](Message msg) { deregisterCamera(msg); });
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_CAMERA_REGISTER, [&](Message msg) { registerCamera(msg); }));
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_CAMERA_DEREGISTER, [&](Message msg) { deregisterCamera(msg); }));
 
 				//Game logic
-				MessageBus::subscribeToMessage(MT_GAME_LOGIC_START, [&](Message msg) { inPlayMode = true; });
-				MessageBus::subscribeToMessage(MT_GAME_LOGIC_STOP, [&](Message msg) { inPlayMode = false; });
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_GAME_LOGIC_START, [&](Message msg) { inPlayMode = true; }));
+				subscriptions.push_back(MessageBus::subscribeToMessage(MT_GAME_LOGIC_STOP, [&](Message msg) { inPlayMode = false; }));
+
+				//Record and submit frames on a dedicated thread if requested
+				if (UserPrefs::getBoolValue("RENDERTHREAD"))
+				{
+#ifdef TRISTEON_EDITOR
+					//The editor gui is built on the main thread while the previous frame would be drawing it
+					Misc::Console::warning("The editor doesn't support RENDERTHREAD, frames are rendered on the main thread.");
+#else
+					renderThread = std::make_unique<RenderThread>();
+#endif
+				}
+			}
+
+			RenderManager::~RenderManager()
+			{
+				//Finish the last frame before anything it uses is destroyed
+				renderThread.reset();
+
+				for (MessageBus::Subscription const& subscription : subscriptions)
+					MessageBus::unsubscribeFromMessage(subscription);
+			}
+
+			void RenderManager::submitFrame(std::function<void()> frame)
+			{
+				if (renderThread != nullptr)
+					renderThread->submit(std::move(frame));
+				else
+					frame();
 			}
 
 			std::vector<Renderer*> RenderManager::getRenderers() const
@@ -48,6 +78,7 @@ namespace Tristeon
 			{
 				//Confirm that we're getting useful data
 				Misc::Console::t_assert(msg.userData != nullptr, "Trying to register null renderer!");
+				RenderThread::sync();
 
 				//Check if renderer
 				Renderer* r = dynamic_cast<Renderer*>(msg.userData);
@@ -74,6 +105,7 @@ namespace Tristeon
 			{
 				//Confirm that we're getting useful data
 				Misc::Console::t_assert(msg.userData != nullptr, "Trying to deregister null renderer!");
+				RenderThread::sync();
 
 				//Check if the given userdata is a renderer, if so, remove from our list
 				Renderer* r = dynamic_cast<Renderer*>(msg.userData);
@@ -94,6 +126,7 @@ namespace Tristeon
 			{
 				//Confirm that we're getting useful data
 				Misc::Console::t_assert(msg.userData != nullptr, "Trying to register null camera!");
+				RenderThread::sync();
 
 				//Try to cast to camera, add to our list if successful
 				Components::Camera* cam = dynamic_cast<Components::Camera*>(msg.userData);
@@ -106,6 +139,7 @@ namespace Tristeon
 			{
 				//Confirm that we're getting useful data
 				Misc::Console::t_assert(msg.userData != nullptr, "Trying to deregister null camera!");
+				RenderThread::sync();
 
 				//Try to cast to camera, remove from our list if successful
 				Components::Camera* cam = dynamic_cast<Components::Camera*>(msg.userData);
@@ -121,11 +155,19 @@ namespace Tristeon
 
 			Material* RenderManager::getMaterial(std::string filePath)
 			{
+				//Headless engines don't have a render manager
+				if (instance == nullptr)
+					return nullptr;
+				TRISTEON_PROFILE_SCOPE("RenderManager::getMaterial");
+				RenderThread::sync();
 				return instance->getmaterial(filePath);
 			}
 
 			Skybox* RenderManager::getSkybox(std::string filePath)
 			{
+				if (instance == nullptr)
+					return nullptr;
+
 				//Try to return the material from our batched materials
 				if (instance->skyboxes.find(filePath) != instance->skyboxes.end())
 					return instance->skyboxes[filePath].get(); //We keep ownership, give the user a reference
@@ -138,6 +180,8 @@ namespace Tristeon
 				if (filesystem::path(filePath).extension() != ".skybox")
 					return nullptr;
 
+				TRISTEON_PROFILE_SCOPE("RenderManager::loadSkybox");
+				RenderThread::sync();
 				return instance->_getSkybox(filePath);
 			}
 		}
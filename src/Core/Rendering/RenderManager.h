@@ -4,6 +4,8 @@
 #include "Skybox.h"
 #include "API/WindowContext.h"
 #include "Core/Rendering/ShaderFile.h"
+#include "Core/MessageBus.h"
+#include "RenderThread.h"
 
 namespace Tristeon
 {
@@ -42,6 +44,10 @@ namespace Tristeon
 			{
 			public:
 				RenderManager();
+				/**
+				 * \brief Unsubscribes from all the messages that this render manager subscribed to
+				 */
+				~RenderManager();
 
 				/**
 				 * \brief Render is an abstract function that is intended to be defined by API specific subclasses. It gets called in the window MT_RENDER callback.
@@ -60,7 +66,13 @@ namespace Tristeon
 				 */
 				virtual void setGridEnabled(bool enable);
 
-				static void recompileShader(std::string filePath) { instance->_recompileShader(filePath); }
+				static void recompileShader(std::string filePath)
+				{
+					if (instance == nullptr)
+						return;
+					RenderThread::sync();
+					instance->_recompileShader(filePath);
+				}
 
 				/**
 				* \brief Returns a material serialized from the given filepath
@@ -71,6 +83,12 @@ namespace Tristeon
 
 				static Skybox* getSkybox(std::string filePath);
 			protected:
+				/**
+				 * \brief Hands the frame over to the render thread, or renders it immediately if there is no render thread.
+				 * Waits until the render thread has finished the previous frame.
+				 */
+				void submitFrame(std::function<void()> frame);
+
 				virtual Skybox* _getSkybox(std::string filePath) = 0;
 				virtual void _recompileShader(std::string filePath) = 0;
 
@@ -146,6 +164,17 @@ namespace Tristeon
 
 				std::unique_ptr<WindowContext> windowContext;
 
+				/**
+				 * \brief The message subscriptions of the render manager, subclasses add theirs as well
+				 */
+				std::vector<MessageBus::Subscription> subscriptions;
+
+				/**
+				 * \brief The thread that frames are rendered on, nullptr if frames are rendered on the main thread.
+				 * Every function that modifies state used by the render thread calls RenderThread::sync() first.
+				 */
+				std::unique_ptr<RenderThread> renderThread;
+
 				/**
 				 * \brief The only instance of RenderManager ever. Used so that getMaterial() can access local variables
 				 */
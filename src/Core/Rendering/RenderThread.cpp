@@ -0,0 +1,85 @@
+﻿#include "RenderThread.h"
+#include "Misc/Profiler.h"
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Rendering
+		{
+			RenderThread* RenderThread::instance = nullptr;
+
+			RenderThread::RenderThread()
+			{
+				thread = std::thread(&RenderThread::threadLoop, this);
+				instance = this;
+			}
+
+			RenderThread::~RenderThread()
+			{
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					condition.wait(lock, [&] { return !busy; });
+					running = false;
+				}
+				condition.notify_all();
+				thread.join();
+
+				instance = nullptr;
+			}
+
+			void RenderThread::sync()
+			{
+				if (instance == nullptr || std::this_thread::get_id() == instance->thread.get_id())
+					return;
+				instance->wait();
+			}
+
+			void RenderThread::submit(std::function<void()> function)
+			{
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					condition.wait(lock, [&] { return !busy; });
+					frame = std::move(function);
+					busy = true;
+				}
+				condition.notify_all();
+			}
+
+			void RenderThread::wait()
+			{
+				TRISTEON_PROFILE_FUNCTION();
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.wait(lock, [&] { return !busy; });
+			}
+
+			void RenderThread::threadLoop()
+			{
+				TRISTEON_PROFILE_THREAD("Render thread");
+
+				while (true)
+				{
+					std::function<void()> function;
+					{
+						std::unique_lock<std::mutex> lock(mutex);
+						condition.wait(lock, [&] { return busy || !running; });
+						if (!busy)
+							return;
+						function = std::move(frame);
+					}
+
+					{
+						TRISTEON_PROFILE_SCOPE("RenderThread::frame");
+						function();
+					}
+
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						busy = false;
+					}
+					condition.notify_all();
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+﻿#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <XPlatform/access.h>
+
+TRISTEON_UNIQUE_ACCESS_DECL()
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		class Engine;
+
+		namespace Rendering
+		{
+			class RenderManager;
+
+			/**
+			 * \brief RenderThread records and submits frames on a dedicated thread, so that the main thread can simulate the next frame in the meantime.
+			 * Enabled through the RENDERTHREAD user pref. The render thread only reads the frame state that the render manager captured for it.
+			 *
+			 * Everything else that the render thread uses (renderers, cameras, materials, meshes and the vulkan resources behind them) may only be modified
+			 * by the main thread after calling sync(). Once sync() returns the render thread stays idle until the render manager submits the next frame.
+			 */
+			class RenderThread final
+			{
+				TRISTEON_UNIQUE_ACCESS(RenderThread)
+				friend RenderManager;
+			public:
+				/**
+				 * \brief Blocks until the render thread has finished the frame it's working on.
+				 * Does nothing if there's no render thread, or if it's called by the render thread itself.
+				 */
+				static void sync();
+
+				/**
+				 * \brief Returns true if frames are rendered on a dedicated thread
+				 */
+				static bool isRunning() { return instance != nullptr; }
+			private:
+				RenderThread();
+				/**
+				 * \brief Finishes the current frame and joins the thread
+				 */
+				~RenderThread();
+
+				/**
+				 * \brief Waits until the previous frame is done, and then hands the given frame over to the render thread
+				 */
+				void submit(std::function<void()> frame);
+				/**
+				 * \brief Waits until the current frame is done
+				 */
+				void wait();
+				/**
+				 * \brief The main loop of the render thread
+				 */
+				void threadLoop();
+
+				std::thread thread;
+				std::mutex mutex;
+				std::condition_variable condition;
+
+				/**
+				 * \brief The frame that's being rendered, busy is true until it has been rendered
+				 */
+				std::function<void()> frame;
+				bool busy = false;
+				bool running = true;
+
+				static RenderThread* instance;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -17,7 +17,7 @@ namespace Tristeon
 				{
 					if (data == nullptr)
 						return;
-					if (drawList.size() == 0)
+					if (lines == nullptr || lines->empty())
 						return;
 
 					render();
@@ -130,9 +130,9 @@ namespace Tristeon
 					secondary.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m->pipeline->getPipelineLayout(), 0, 2, sets, 0, nullptr);
 
 					int i = 0;
-					while (!drawList.empty())
+					while (!lines->empty())
 					{
-						Line const l = drawList.front();
+						Line const l = lines->front();
 
 						//TODO: Fix colors (only the last color is applied coz the same buffer is being used)
 						material->setColor("Color.color", l.color);
@@ -160,7 +160,7 @@ namespace Tristeon
 						//Draw
 						secondary.draw((uint32_t)mesh.vertices.size(), 1, 0, 0);
 
-						drawList.pop();
+						lines->pop();
 						
 						i++;
 					}
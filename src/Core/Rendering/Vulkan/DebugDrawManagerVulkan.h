@@ -45,6 +45,10 @@ namespace Tristeon
 					 * \brief The renderdata struct, given to us by vkRenderManager
 					 */
 					RenderData* data = nullptr;
+					/**
+					 * \brief The lines of the frame that is being rendered, given to us by vkRenderManager. Emptied by draw().
+					 */
+					std::queue<Line>* lines = nullptr;
 
 					/**
 					 * \brief Destroys the debug draw manager and deallocates all the resources created by it
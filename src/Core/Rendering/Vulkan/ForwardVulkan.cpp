@@ -69,11 +69,14 @@ namespace Tristeon
 		
 #ifdef TRISTEON_EDITOR
 					//Draw grid
-					if (!vkRenderManager->inPlayMode && vkRenderManager->grid != nullptr)
+					//The grid isn't registered, and the editor renders on the main thread, so it's captured here
+					RendererState gridState;
+					if (!vkRenderManager->frame->inPlayMode && vkRenderManager->grid != nullptr && vkRenderManager->grid->renderer->capture(gridState))
 					{
 						data.lastUsedSecondaryBuffer = nullptr;
 
 						vkRenderManager->grid->renderer->data = &data;
+						vkRenderManager->grid->renderer->state = &gridState;
 						vkRenderManager->grid->renderer->render();
 
 						if ((VkCommandBuffer)data.lastUsedSecondaryBuffer != nullptr)
@@ -88,6 +91,7 @@ namespace Tristeon
 						if (ddmngr != nullptr)
 						{
 							ddmngr->data = &data;
+							ddmngr->lines = &vkRenderManager->frame->lines;
 							ddmngr->draw();
 							if ((VkCommandBuffer)data.lastUsedSecondaryBuffer != nullptr)
 								buffers.push_back(data.lastUsedSecondaryBuffer);
@@ -95,11 +99,13 @@ namespace Tristeon
 					}
 
 					//Draw scene
-					for (InternalMeshRenderer* r : vkRenderManager->internalRenderers)
+					for (RendererState const& state : vkRenderManager->frame->renderers)
 					{
 						data.lastUsedSecondaryBuffer = nullptr;
 
+						InternalMeshRenderer* r = state.renderer;
 						r->data = &data;
+						r->state = &state;
 						r->render();
 
 						if ((VkCommandBuffer)data.lastUsedSecondaryBuffer != nullptr)
@@ -169,17 +175,17 @@ namespace Tristeon
 					data.primary = primary;
 
 					//Only draw cameras in playmode
-					if (vkRenderManager->inPlayMode)
+					if (vkRenderManager->frame->inPlayMode)
 					{
 						//Draw every camera
-						for (auto const p : vkRenderManager->cameraData)
+						for (CameraState const& camera : vkRenderManager->frame->cameras)
 						{
-							vk::CommandBuffer b = p.second->onscreen.secondary;
+							vk::CommandBuffer b = camera.data->onscreen.secondary;
 							b.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eRenderPassContinue, &inheritance));
 							b.setViewport(0, 1, &data.viewport);
 							b.setScissor(0, 1, &data.scissor);
 							b.bindPipeline(vk::PipelineBindPoint::eGraphics, vkRenderManager->onscreenPipeline->getPipeline());
-							b.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, vkRenderManager->onscreenPipeline->getPipelineLayout(), 0, p.second->onscreen.sets.size(), p.second->onscreen.sets.data(), 0, nullptr);
+							b.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, vkRenderManager->onscreenPipeline->getPipelineLayout(), 0, camera.data->onscreen.sets.size(), camera.data->onscreen.sets.data(), 0, nullptr);
 							b.draw(3, 1, 0, 0);
 							b.end();
 							buffers.push_back(b);
@@ -41,28 +41,49 @@ namespace Tristeon
 					bindingData->device.freeDescriptorSets(bindingData->descriptorPool, 1, &set);
 				}
 
-				void InternalMeshRenderer::render()
+				bool InternalMeshRenderer::capture(RendererState& state)
 				{
-					if (meshRenderer->mesh.get().vertices.size() == 0 || meshRenderer->mesh.get().indices.size() == 0)
-						return;
-					if ((VkBuffer)vertexBuffer->getBuffer() == VK_NULL_HANDLE || (VkBuffer)indexBuffer->getBuffer() == VK_NULL_HANDLE)
+					Data::SubMesh const& mesh = meshRenderer->_mesh;
+					if (mesh.vertices.size() == 0 || mesh.indices.size() == 0)
+						return false;
+					if (vertexBuffer == nullptr || indexBuffer == nullptr || (VkBuffer)vertexBuffer->getBuffer() == VK_NULL_HANDLE || (VkBuffer)indexBuffer->getBuffer() == VK_NULL_HANDLE)
 					{
 						Misc::Console::warning("Not rendering [" + meshRenderer->gameObject.get()->name + "] because either the vertex or index buffer hasn't been set up!");
-						return;
+						return false;
 					}
 
-					//Get our material, and render it with the meshrenderer's model matrix
-					Rendering::Material* m = meshRenderer->material.get();
-					glm::mat4 const model = meshRenderer->transform.get()->getTransformationMatrix();
-
-					Vulkan::Material* vkm = dynamic_cast<Vulkan::Material*>(m);
+					//Get our material, it's rendered with the meshrenderer's model matrix
+					Vulkan::Material* vkm = dynamic_cast<Vulkan::Material*>(meshRenderer->material.get());
 					if (vkm == nullptr)
-						return;
+						return false;
 					if ((VkDescriptorSet)set == VK_NULL_HANDLE || (VkDescriptorSet)vkm->set == VK_NULL_HANDLE)
-						return;
+						return false;
+
+					Transform* const transform = meshRenderer->transform.get();
+					state.renderer = this;
+					state.material = vkm;
+					state.version = transform->getVersion();
+					state.model = transform->getTransformationMatrix();
+					state.indexCount = uint32_t(mesh.indices.size());
+					return true;
+				}
+
+				void InternalMeshRenderer::render()
+				{
+					Vulkan::Material* vkm = state->material;
 
-					vkm->setActiveUniformBufferMemory(uniformBuffer->getDeviceMemory());
-					vkm->render(model, data->view, data->projection);
+					//Our uniform buffer keeps its contents, so it only needs to be written if the transform or the camera has changed
+					if (state->version != uploadedVersion || data->view != uploadedView || data->projection != uploadedProjection)
+					{
+						vkm->setActiveUniformBufferMemory(uniformBuffer->getDeviceMemory());
+						if (vkm->uploadTransform(state->model, data->view, data->projection))
+						{
+							uploadedVersion = state->version;
+							uploadedView = data->view;
+							uploadedProjection = data->projection;
+						}
+					}
+					vkm->uploadProperties();
 
 					//Start secondary cmd buffer
 					const vk::CommandBufferBeginInfo beginInfo = vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eRenderPassContinue, &data->inheritance);
@@ -92,7 +113,7 @@ namespace Tristeon
 					secondary.setLineWidth(2);
 
 					//Draw
-					secondary.drawIndexed(meshRenderer->mesh.get().indices.size(), 1, 0, 0, 0);
+					secondary.drawIndexed(state->indexCount, 1, 0, 0, 0);
 
 					//Stop secondary cmd buffer
 					secondary.end();
@@ -102,6 +123,8 @@ namespace Tristeon
 
 				void InternalMeshRenderer::onMeshChange(Data::SubMesh mesh)
 				{
+					//The buffers might be in use by the frame that's being rendered
+					RenderThread::sync();
 					createVertexBuffer(mesh);
 					createIndexBuffer(mesh);
 				}
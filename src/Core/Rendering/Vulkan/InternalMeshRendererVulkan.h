@@ -41,6 +41,12 @@ namespace Tristeon
 					 */
 					void render() override;
 
+					/**
+					 * \brief Copies the data that render() needs from the mesh renderer, called on the main thread.
+					 * \return False if there's nothing to render
+					 */
+					bool capture(RendererState& state);
+
 					/**
 					* \brief Callback function for when the mesh has been changed
 					* \param mesh The new mesh
@@ -64,6 +70,10 @@ namespace Tristeon
 					 * \brief Rendering data, set by the renderer
 					 */
 					RenderData* data = nullptr;
+					/**
+					 * \brief The captured state of the mesh renderer, set by the renderer
+					 */
+					RendererState const* state = nullptr;
 
 					/**
 					 * \brief The mesh renderer this internal renderer is attached to
@@ -79,6 +89,14 @@ namespace Tristeon
 					std::unique_ptr<BufferVulkan> indexBuffer;
 					std::unique_ptr<BufferVulkan> uniformBuffer;
 
+					/**
+					 * \brief The transform version and camera matrices that were last written to the uniform buffer.
+					 * Transform versions start at 1, so the first frame always uploads.
+					 */
+					uint32_t uploadedVersion = 0;
+					glm::mat4 uploadedView;
+					glm::mat4 uploadedProjection;
+
 					/**
 					 * \brief Allocates the command buffers
 					 */
@@ -29,11 +29,18 @@ namespace Tristeon
 				}
 
 				void Material::render(glm::mat4 model, glm::mat4 view, glm::mat4 proj)
+				{
+					if (!uploadTransform(model, view, proj))
+						return;
+					uploadProperties();
+				}
+
+				bool Material::uploadTransform(glm::mat4 const& model, glm::mat4 const& view, glm::mat4 const& proj) const
 				{
 					if ((VkDeviceMemory)uniformBufferMem == VK_NULL_HANDLE)
 					{
 						Misc::Console::warning("Vulkan::Material::uniformBufferMem has not been set! Object's transform will be off!");
-						return;
+						return false;
 					}
 
 					//Creat data
@@ -48,7 +55,11 @@ namespace Tristeon
 					pipeline->device.mapMemory(uniformBufferMem, 0, sizeof(ubo), {}, &data);
 					memcpy(data, &ubo, sizeof ubo);
 					pipeline->device.unmapMemory(uniformBufferMem);
+					return true;
+				}
 
+				void Material::uploadProperties()
+				{
 					//Verify data
 					if (shader == nullptr)
 					{
@@ -61,7 +72,7 @@ namespace Tristeon
 						return;
 					}
 
-					//TODO: This should be a separate function for recursiveness in structs and such
+					//TODO: packProperty should recurse into nested structs
 					//Other data
 					for (const auto pair : shader->getProps())
 					{
@@ -71,72 +82,11 @@ namespace Tristeon
 							continue;
 
 						void* mem = malloc(p.size);
-
-						switch (p.valueType)
-						{
-						case DT_Color:
-						{
-							Misc::Color const c = colors[p.name];
-							glm::vec4 col = glm::vec4(c.r, c.g, c.b, c.a);
-							memcpy(mem, &col, sizeof(glm::vec4));
-							break;
-						}
-						case DT_Float:
-						{
-							float f = floats[p.name];
-							memcpy(mem, &f, sizeof(float));
-							break;
-						}
-						case DT_Vector3:
-						{
-							Math::Vector3 const vec = vectors[p.name];
-							glm::vec3 v = Vec_Convert3(vec);
-							memcpy(mem, &v, sizeof(glm::vec3));
-							break;
-						}
-						case DT_Struct:
-						{
-							//Cast mem (malloc(p.size)) byte array 
-							uint8_t* ptr = reinterpret_cast<uint8_t*>(mem);
-
-							//Fill allocated memory with our data
-							for (auto c : p.children)
-							{
-								switch (c.valueType)
-								{
-								case DT_Float:
-								{
-									float f = floats[p.name + "." + c.name];
-									memcpy(ptr, &f, sizeof(float));
-									ptr += sizeof(float);
-									break;
-								}
-								case DT_Color:
-								{
-									const auto col = colors[p.name + "." + c.name];
-									glm::vec4 color = glm::vec4(col.r, col.g, col.b, col.a);
-									memcpy(ptr, &color, sizeof(glm::vec4));
-									ptr += sizeof(glm::vec4);
-									break;
-								}
-								case DT_Vector3:
-								{
-									Math::Vector3 const vec = vectors[p.name + "." + c.name];
-									glm::vec3 v = glm::vec3(vec.x, vec.y, vec.z);
-									memcpy(ptr, &v, sizeof(glm::vec3));
-									ptr += sizeof(glm::vec3);
-									break;
-								}
-								}
-							}
-							break;
-						}
-						default:
+						if (!packProperty(p, reinterpret_cast<uint8_t*>(mem)))
 						{
 							free(mem);
 							continue;
 						}
-						}
 
 						uniformBuffers[p.name]->copyFromData(mem);
 						free(mem);
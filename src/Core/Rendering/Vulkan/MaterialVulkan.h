@@ -92,6 +92,15 @@ namespace Tristeon
 					 * \param proj The projection matrix of the current camera
 					 */
 					void render(glm::mat4 model, glm::mat4 view, glm::mat4 proj) override;
+					/**
+					 * \brief Writes the model, view and projection matrices to the active uniform buffer memory
+					 * \return False if there is no active uniform buffer memory
+					 */
+					bool uploadTransform(glm::mat4 const& model, glm::mat4 const& view, glm::mat4 const& proj) const;
+					/**
+					 * \brief Writes the shader properties of this material to their uniform buffers, and resets the active uniform buffer memory
+					 */
+					void uploadProperties();
 					/**
 					 * \brief Creates the vulkan texture data for the images
 					 */
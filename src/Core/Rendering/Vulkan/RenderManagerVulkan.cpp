@@ -5,7 +5,6 @@
 #include "Core/Message.h"
 #include "Core/UserPrefs.h"
 #include "Misc/Console.h"
-#include "Math/Vector2.h"
 #include "Core/Transform.h"
 
 #include "Core/MessageBus.h"
@@ -32,6 +31,7 @@
 #include "SkyboxVulkan.h"
 #include "../Skybox.h"
 #include "Misc/ObjectPool.h"
+#include "Misc/FrameStats.h"
 #include "Core/GameObject.h"
 #include "API/WindowContextVulkan.h"
 
@@ -50,14 +50,16 @@ namespace Tristeon
 			{
 				RenderManager::RenderManager() : window(BindingData::getInstance()->window)
 				{
-					MessageBus::subscribeToMessage(MT_WINDOW_RESIZE, [&](Message msg)
+					subscriptions.push_back(MessageBus::subscribeToMessage(MT_WINDOW_RESIZE, [&](Message msg)
 					{
-						Math::Vector2* vec = reinterpret_cast<Math::Vector2*>(msg.userData);
-						resizeWindow(static_cast<int>(vec->x), static_cast<int>(vec->y));
-					});
+						RenderThread::sync();
+						int width, height;
+						glfwGetWindowSize(window, &width, &height);
+						resizeWindow(width, height);
+					}));
 
 #ifdef TRISTEON_EDITOR
-					MessageBus::subscribeToMessage(MT_PRERENDER, [&](Message msg) { MessageBus::sendMessage({ MT_SHARE_DATA, &editor }); });
+					subscriptions.push_back(MessageBus::subscribeToMessage(MT_PRERENDER, [&](Message msg) { MessageBus::sendMessage({ MT_SHARE_DATA, &editor }); }));
 #endif
 
 					//Create render technique
@@ -87,10 +89,67 @@ namespace Tristeon
 				{
 					//TODO: This should be done in the base class. Leave room for customization tho
 
+					//Capture this frame while the render thread might still be rendering the previous one
+					FrameState& captured = frames[captureIndex];
+					captureFrame(captured);
+					captureIndex = 1 - captureIndex;
+
+					//Submitting waits for the previous frame, which frees up the other frame state for the next capture
+					submitFrame([this, &captured]() { renderFrame(captured); });
+				}
+
+				void RenderManager::captureFrame(FrameState& captured)
+				{
+					captured.inPlayMode = inPlayMode;
+
+					captured.renderers.clear();
+					for (InternalMeshRenderer* r : internalRenderers)
+					{
+						RendererState state;
+						if (r->capture(state))
+							captured.renderers.push_back(state);
+					}
+
+					captured.cameras.clear();
+					if (inPlayMode)
+					{
+						vk::Extent2D const extent = vkContext->getExtent();
+						for (auto const cam : cameraData)
+						{
+							CameraState state;
+							state.data = cam.second;
+							state.view = cam.first->getViewMatrix();
+							state.projection = cam.first->getProjectionMatrix((float)extent.width / (float)extent.height);
+							state.skybox = cam.first->getSkybox();
+							captured.cameras.push_back(state);
+						}
+					}
+#ifdef TRISTEON_EDITOR
+					else if (editor.cam != nullptr)
+					{
+						CameraState state;
+						state.data = editor.cam;
+						state.view = Components::Camera::getViewMatrix(editor.trans);
+						state.projection = Components::Camera::getProjectionMatrix((float)editor.size.x / (float)editor.size.y, 60, 0.1f, 1000.0f);
+						state.skybox = editorSkybox;
+						captured.cameras.push_back(state);
+					}
+#endif
+
+					//Take the lines that were added during this frame, new lines go into an empty list
+					std::queue<Rendering::DebugDrawManager::Line>().swap(captured.lines);
+					Vulkan::DebugDrawManager* ddmngr = (Vulkan::DebugDrawManager*)DebugDrawManager::instance;
+					if (ddmngr != nullptr)
+						std::swap(captured.lines, ddmngr->drawList);
+				}
+
+				void RenderManager::renderFrame(FrameState& rendered)
+				{
 					//Don't render anything if there's nothing to render
-					if (internalRenderers.size() == 0 && renderables.size() == 0)
+					if (rendered.renderers.size() == 0 && renderables.size() == 0)
 						return;
-					
+
+					frame = &rendered;
 					windowContext->prepareFrame();
 
 					//Render scene
@@ -102,7 +161,11 @@ namespace Tristeon
 					//Submit frame
 					submitCameras();
 
-					windowContext->finishFrame();
+					{
+						Misc::FramePhaseTimer const timer(Misc::FP_PRESENT);
+						windowContext->finishFrame();
+					}
+					frame = nullptr;
 				}
 
 				Pipeline* RenderManager::getPipeline(ShaderFile file)
@@ -127,30 +190,15 @@ namespace Tristeon
 
 				void RenderManager::renderScene()
 				{
-					if (!inPlayMode)
-					{
-#ifdef TRISTEON_EDITOR
-						//Render editor camera
-						glm::mat4 const view = Components::Camera::getViewMatrix(editor.trans);
-						glm::mat4 const proj = Components::Camera::getProjectionMatrix((float)editor.size.x / (float)editor.size.y, 60, 0.1f, 1000.0f);
-						technique->renderScene(view, proj, editor.cam, editorSkybox);
-#endif
-					}
-					else
-					{
-						//Render gameplay cameras
-						for (auto const cam : cameraData)
-						{
-							vk::Extent2D const extent = vkContext->getExtent();
-							glm::mat4 const view = cam.first->getViewMatrix();
-							glm::mat4 const proj = cam.first->getProjectionMatrix((float)extent.width / (float)extent.height);
-							technique->renderScene(view, proj, cam.second, cam.first->getSkybox());
-						}
-					}
+					//Gameplay cameras in play mode, the editor camera otherwise
+					for (CameraState const& camera : frame->cameras)
+						technique->renderScene(camera.view, camera.projection, camera.data, camera.skybox);
 				}
 
 				RenderManager::~RenderManager()
 				{
+					RenderThread::sync();
+
 					//Wait till the device is finished
 					vk::Device d = vkContext->getDevice();
 					d.waitIdle();
@@ -248,32 +296,15 @@ namespace Tristeon
 					vkContext->getPresentQueue().waitIdle();
 					vk::PipelineStageFlags waitStages[] = { vk::PipelineStageFlagBits::eColorAttachmentOutput };
 
+					//Submit cameras, gameplay cameras in play mode and the editor camera otherwise
 					CameraRenderData* last = nullptr;
-					if (inPlayMode)
+					for (CameraState const& camera : frame->cameras)
 					{
-						//Submit cameras
-						for (const auto p : cameraData)
-						{
-							CameraRenderData* c = p.second;
-							vk::Semaphore wait = last == nullptr ? imgav : last->offscreen.sema;
-							vk::SubmitInfo s = vk::SubmitInfo(1, &wait, waitStages, 1, &c->offscreen.cmd, 1, &c->offscreen.sema );
-							vkContext->getGraphicsQueue().submit(1, &s, nullptr);
-							last = c;
-						}
-					}
-					else
-					{
-#ifdef TRISTEON_EDITOR
-						//Submit editor camera
-						CameraRenderData* c = editor.cam;
-						if (c != nullptr)
-						{
-							vk::Semaphore wait = imgav;
-							vk::SubmitInfo s = vk::SubmitInfo(1, &wait, waitStages, 1, &c->offscreen.cmd, 1, &c->offscreen.sema);
-							vkContext->getGraphicsQueue().submit(1, &s, nullptr);
-							last = c;
-						}
-#endif
+						CameraRenderData* c = camera.data;
+						vk::Semaphore wait = last == nullptr ? imgav : last->offscreen.sema;
+						vk::SubmitInfo s = vk::SubmitInfo(1, &wait, waitStages, 1, &c->offscreen.cmd, 1, &c->offscreen.sema );
+						vkContext->getGraphicsQueue().submit(1, &s, nullptr);
+						last = c;
 					}
 					
 					//Submit onscreen
@@ -4,9 +4,11 @@
 #include <vulkan/vulkan.hpp>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
+#include <queue>
 
 #include "Math/Vector2.h"
 #include "Misc/ObjectPool.h"
+#include "Core/Rendering/DebugDrawManager.h"
 
 namespace Tristeon
 {
@@ -23,6 +25,7 @@ namespace Tristeon
 			{
 				class CameraRenderData;
 				class InternalMeshRenderer;
+				class Material;
 				class Pipeline;
 				class Forward;
 				class Device;
@@ -92,6 +95,45 @@ namespace Tristeon
 					vk::DescriptorSet skyboxSet;
 				};
 
+				/**
+				 * \brief RendererState is the state of a mesh renderer at the end of a simulated frame.
+				 * The internal renderer reads this instead of its component, which the simulation might be modifying in the meantime.
+				 */
+				struct RendererState
+				{
+					InternalMeshRenderer* renderer = nullptr;
+					Material* material = nullptr;
+					glm::mat4 model;
+					/**
+					 * \brief The transform version of model, used to skip redundant uniform buffer uploads
+					 */
+					uint32_t version = 0;
+					uint32_t indexCount = 0;
+				};
+
+				/**
+				 * \brief CameraState is the state of a camera at the end of a simulated frame
+				 */
+				struct CameraState
+				{
+					CameraRenderData* data = nullptr;
+					glm::mat4 view;
+					glm::mat4 projection;
+					Rendering::Skybox* skybox = nullptr;
+				};
+
+				/**
+				 * \brief FrameState is everything a frame needs from the simulation, captured on the main thread at MT_RENDER.
+				 * The render manager keeps two of them, so that the next frame can be captured while the render thread renders the previous one.
+				 */
+				struct FrameState
+				{
+					bool inPlayMode = false;
+					std::vector<RendererState> renderers;
+					std::vector<CameraState> cameras;
+					std::queue<Rendering::DebugDrawManager::Line> lines;
+				};
+
 				/**
 				 * \brief Vulkan::RenderManager is the vulkan implementation of the RenderManager
 				 */
@@ -166,6 +208,15 @@ namespace Tristeon
 					 */
 					void createCommandBuffer();
 
+					/**
+					 * \brief Copies the state of the renderers, cameras and debug lines into the given frame. Called on the main thread.
+					 */
+					void captureFrame(FrameState& frame);
+					/**
+					 * \brief Records, submits and presents the given frame. Called on the render thread if there is one.
+					 */
+					void renderFrame(FrameState& frame);
+
 					/**
 					 * \brief Renders the scene for each camera
 					 */
@@ -206,6 +257,16 @@ namespace Tristeon
 					vk::CommandBuffer primaryCmd;
 
 					vector<InternalMeshRenderer*> internalRenderers;
+
+					/**
+					 * \brief The double buffered frame state, frames[captureIndex] is captured next
+					 */
+					std::array<FrameState, 2> frames;
+					size_t captureIndex = 0;
+					/**
+					 * \brief The frame that is being rendered, only set during renderFrame()
+					 */
+					FrameState* frame = nullptr;
 					std::map<Components::Camera*, CameraRenderData*> cameraData;
 					ObjectPool<CameraRenderData*> cameraDataPool;
 #ifdef TRISTEON_EDITOR
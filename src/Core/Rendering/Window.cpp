@@ -4,7 +4,6 @@
 #include <Core/MessageBus.h>
 #include "Core/Message.h"
 
-#include "Math/Vector2.h"
 
 #include "Misc/Console.h"
 
@@ -65,8 +64,7 @@ namespace Tristeon
 			{
 				this->width.value = width;
 				this->height.value = height;
-				Math::Vector2 size = Math::Vector2((float)width, (float)height);
-				MessageBus::sendMessage(Message(MT_WINDOW_RESIZE, &size));
+				MessageBus::sendMessage(Message(MT_WINDOW_RESIZE));
 			}
 		}
 	}
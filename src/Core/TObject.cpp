@@ -1,21 +1,94 @@
 ﻿#include <Core/TObject.h>
 #include "Misc/Console.h"
-#include "Misc/StringUtils.h"
+#include <atomic>
+#include <chrono>
+#include <random>
 
 namespace Tristeon
 {
 	namespace Core
 	{
-		TObject::TObject()
+		static uint64_t randomInstanceIDSeed()
 		{
-			instanceID = StringUtils::generateRandom(12);
+			std::random_device device;
+			uint64_t const random = (uint64_t(device()) << 32) | device();
+			return random ^ uint64_t(std::chrono::high_resolution_clock::now().time_since_epoch().count());
 		}
 
-		std::string TObject::getInstanceID() const
+		/**
+		 * The next block of instanceIDs to hand out. Starts at a random value, so objects created in different sessions don't share IDs.
+		 */
+		static std::atomic<uint64_t> nextInstanceIDBlock(randomInstanceIDSeed());
+
+		/**
+		 * Every thread claims instanceIDs in blocks, so creating objects doesn't contend on the atomic
+		 */
+		static const uint64_t instanceIDBlockSize = 1024;
+
+		TObject::TObject() : instanceID(generateInstanceID())
+		{
+		}
+
+		uint64_t TObject::getInstanceID() const
 		{
 			return instanceID;
 		}
 
+		std::string TObject::instanceIDToString(uint64_t instanceID)
+		{
+			static const char digits[] = "0123456789abcdef";
+
+			std::string output(16, '0');
+			for (int i = 15; i >= 0; i--)
+			{
+				output[i] = digits[instanceID & 0xf];
+				instanceID >>= 4;
+			}
+			return output;
+		}
+
+		uint64_t TObject::instanceIDFromString(std::string const& instanceID)
+		{
+			if (instanceID.empty() || instanceID == "null")
+				return invalidInstanceID;
+
+			uint64_t result = 0;
+			bool isHex = instanceID.size() == 16;
+			for (size_t i = 0; i < instanceID.size() && isHex; i++)
+			{
+				char const c = instanceID[i];
+				if (c >= '0' && c <= '9')
+					result = (result << 4) | uint64_t(c - '0');
+				else if (c >= 'a' && c <= 'f')
+					result = (result << 4) | uint64_t(c - 'a' + 10);
+				else
+					isHex = false;
+			}
+			if (isHex)
+				return result;
+
+			//FNV-1a, used for the string IDs of older files
+			result = 14695981039346656037ull;
+			for (char const c : instanceID)
+				result = (result ^ uint64_t(uint8_t(c))) * 1099511628211ull;
+			return result == invalidInstanceID ? 1 : result;
+		}
+
+		uint64_t TObject::generateInstanceID()
+		{
+			thread_local uint64_t next = 0;
+			thread_local uint64_t end = 0;
+
+			if (next == end)
+			{
+				next = nextInstanceIDBlock.fetch_add(instanceIDBlockSize, std::memory_order_relaxed);
+				end = next + instanceIDBlockSize;
+			}
+
+			uint64_t const id = next++;
+			return id == invalidInstanceID ? generateInstanceID() : id;
+		}
+
 		void TObject::print(std::string data)
 		{
 			Misc::Console::write(data);
@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include <cstdint>
 #include <string>
 #include "Editor/Serializable.h"
 
@@ -8,7 +9,8 @@ namespace Tristeon
 	{
 		/**
 		 * TObject is the base class of all Tristeon classes.
-		 * Every TObject contains a name and a instanceID. The instanceID is a unique string generated upon creation or loaded in through serialization.
+		 * Every TObject contains a name and a instanceID. The instanceID is a unique 64-bit integer generated upon creation or loaded in through serialization.
+		 * InstanceIDs are only converted to strings when they are serialized.
 		 */
 		class TObject : public Serializable
 		{
@@ -18,14 +20,35 @@ namespace Tristeon
 			TObject();
 
 			std::string name;
-			std::string getInstanceID() const;
+			uint64_t getInstanceID() const;
+
+			/**
+			 * The instanceID that is never assigned to an object. Used to describe a missing reference, such as a transform without a parent.
+			 */
+			static const uint64_t invalidInstanceID = 0;
+
+			/**
+			 * Converts the instanceID to the string that is stored in json files
+			 */
+			static std::string instanceIDToString(uint64_t instanceID);
+			/**
+			 * Converts a serialized instanceID back to an instanceID.
+			 * Strings that weren't created by instanceIDToString (e.g. the random string IDs of older files) are hashed,
+			 * so references between objects in older files stay intact.
+			 */
+			static uint64_t instanceIDFromString(std::string const& instanceID);
 
 			/**
 			 * Prints the given data to the console. Only in Debug/ReleaseDebug/Editor.
 			 */
 			static void print(std::string data);
 		private:
-			std::string instanceID;
+			/**
+			 * Returns a new unique instanceID. Thread safe.
+			 */
+			static uint64_t generateInstanceID();
+
+			uint64_t instanceID;
 		};
 	}
 }
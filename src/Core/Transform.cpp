@@ -1,6 +1,6 @@
 ﻿#include "Transform.h"
 
-#include <glm/gtx/matrix_decompose.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include "XPlatform/typename.h"
 
 namespace Tristeon
@@ -9,32 +9,48 @@ namespace Tristeon
 	{
 		REGISTER_TYPE_CPP(Transform)
 
+		Transform::Transform() : index(TransformStore::create(this)), handle(HandleTable<Transform>::create(this))
+		{
+		}
+
 		Transform::~Transform()
 		{
 			//Remove all our children
-			for (int i = 0; i < children.size(); i++)
-				children[i]->parent = nullptr;
+			for (size_t i = 0; i < children.size(); i++)
+			{
+				if (Transform* child = children[i].get())
+				{
+					child->parent = {};
+					TransformStore::setParent(child->index, TransformStore::noParent);
+					child->markDirty(TransformStore::DIRTY_WORLD | TransformStore::DIRTY_WORLD_TRS);
+				}
+			}
 			children.clear();
 
-			if (parent != nullptr)
-				parent->children.remove(this);
-			parent = nullptr;
+			if (Transform* p = parent.get())
+				p->children.remove(handle);
+			parent = {};
+
+			TransformStore::destroy(index);
+			HandleTable<Transform>::destroy(handle);
 		}
 
 		void Transform::setParent(Transform* parent, bool keepWorldTransform)
 		{
 			//Can't parent to ourselves. TODO: In a deeper parent hierarchy, we could still accidentally parent loop.
-			if (parent == this || parent != nullptr && parent->parent == this)
+			if (parent == this || parent != nullptr && parent->parent == handle)
 				return;
 
 			//Deregister ourselves from our old parent
-			if (this->parent != nullptr)
-				this->parent->children.remove(this);
+			if (Transform* oldParent = this->parent.get())
+				oldParent->children.remove(handle);
 
 			//Add ourselves to the new parent
 			if (parent != nullptr)
-				parent->children.push_back(this);
+				parent->children.push_back(handle);
 
+			Handle<Transform> const parentHandle = parent != nullptr ? parent->handle : Handle<Transform>();
+			uint32_t const parentIndex = parent != nullptr ? parent->index : TransformStore::noParent;
 			if (keepWorldTransform)
 			{
 				//Store old transformation
@@ -42,7 +58,9 @@ namespace Tristeon
 				Math::Vector3 const oldGlobalScale = scale.get();
 				Math::Quaternion const oldGlobalRot = rotation.get();
 
-				this->parent = parent;
+				this->parent = parentHandle;
+				TransformStore::setParent(index, parentIndex);
+				markDirty(TransformStore::DIRTY_WORLD | TransformStore::DIRTY_WORLD_TRS);
 
 				//Reset transform
 				position.set(oldGlobalPos);
@@ -51,7 +69,9 @@ namespace Tristeon
 			}
 			else
 			{
-				this->parent = parent;
+				this->parent = parentHandle;
+				TransformStore::setParent(index, parentIndex);
+				markDirty(TransformStore::DIRTY_WORLD | TransformStore::DIRTY_WORLD_TRS);
 			}
 		}
 
@@ -59,25 +79,23 @@ namespace Tristeon
 		{
 			nlohmann::json output;
 			output["typeID"] = TRISTEON_TYPENAME(Transform);
-			output["instanceID"] = getInstanceID();
-			output["parentID"] = parent == nullptr ? "null" : parent->getInstanceID();
-			output["localPosition"] = _localPosition.serialize();
-			output["localScale"] = _localScale.serialize();
-			output["localRotation"] = _localRotation.eulerAngles().serialize();
+			output["instanceID"] = instanceIDToString(getInstanceID());
+			output["parentID"] = !parent ? "null" : instanceIDToString(parent.get()->getInstanceID());
+			output["localPosition"] = localPosition.get();
+			output["localScale"] = localScale.get();
+			output["localRotation"] = localRotation.get().eulerAngles();
 			return output;
 		}
 
 		void Transform::deserialize(nlohmann::json json)
 		{
 			const std::string instanceIDValue = json["instanceID"];
-			instanceID = instanceIDValue;
+			instanceID = instanceIDFromString(instanceIDValue);
 			const std::string parentIDValue = json["parentID"];
-			parentID = parentIDValue;
-			_localPosition.deserialize(json["localPosition"]);
-			_localScale.deserialize(json["localScale"]);
-			Math::Vector3 eulerAngles;
-			eulerAngles.deserialize(json["localRotation"]);
-			_localRotation = Math::Quaternion::euler(eulerAngles);
+			parentID = instanceIDFromString(parentIDValue);
+			localPosition = json["localPosition"].get<Math::Vector3>();
+			localScale = json["localScale"].get<Math::Vector3>();
+			localRotation = Math::Quaternion::euler(json["localRotation"].get<Math::Vector3>());
 		}
 
 		Math::Vector3 Transform::transformPoint(Math::Vector3 point)
@@ -96,15 +114,10 @@ namespace Tristeon
 		{
 			Math::Vector3 const pos = position.get();
 			Math::Vector3 const tar = target->position.get();
-			glm::mat4 const transf = glm::inverse(glm::lookAt(glm::vec3(pos.x, pos.y, pos.z ), { tar.x, tar.y, tar.z }, { up.x, up.y, up.z } ));
-
-			glm::vec3 s, p;
-			glm::quat r;
-			glm::vec3 skew;
-			glm::vec4 persp;
-			decompose(transf, s, r, p, skew, persp);
+			glm::mat4 const view = glm::lookAt(glm::vec3(pos.x, pos.y, pos.z ), { tar.x, tar.y, tar.z }, { up.x, up.y, up.z } );
 
-			rotation = Math::Quaternion(r);
+			//The rotation part of the view matrix is orthonormal, so its inverse is its transpose
+			rotation = Math::Quaternion(glm::quat_cast(glm::transpose(glm::mat3(view))));
 		}
 
 		Math::Vector3 Transform::up()
@@ -124,128 +137,96 @@ namespace Tristeon
 
 		Math::Vector3 Transform::getGlobalPosition()
 		{
-			if (parent == nullptr)
-				return _localPosition;
+			if (!parent)
+				return localPosition.get();
 			else
-				return Vec_Convert3(getTransformationMatrix()[3]);
+				return Math::Vector3(glm::vec3(getTransformationMatrix()[3]));
 		}
 
 		void Transform::setGlobalPosition(Math::Vector3 pos)
 		{
-			if (parent == nullptr)
-				_localPosition = pos;
+			if (!parent)
+				localPosition = pos;
 			else
-				_localPosition = parent->inverseTransformPoint(pos);
+				localPosition = parent.get()->inverseTransformPoint(pos);
 		}
 
 		Math::Vector3 Transform::getGlobalScale()
 		{
-			if (parent == nullptr)
-				return _localScale;
-
-			//Get scale off our transformation matrix
-			glm::mat4 const trans = getTransformationMatrix();
+			if (!parent)
+				return localScale.get();
 
-			glm::vec3 scale;
-			//Unused variables but required in the function
-			glm::quat rotation;
-			glm::vec3 translation;
-			glm::vec3 skew;
-			glm::vec4 perspective;
-			decompose(trans, scale, rotation, translation, skew, perspective);
-
-			return Vec_Convert3(scale);
+			TransformStore::updateWorldTRS(index);
+			return Math::Vector3(TransformStore::worldScales[index]);
 		}
 
 		void Transform::setGlobalScale(Math::Vector3 scale)
 		{
-			if (parent == nullptr)
-				_localScale = scale;
+			if (!parent)
+				localScale = scale;
 			else
 			{
-				glm::mat4 const p = parent->getTransformationMatrix();
-
-				glm::vec3 s;
-				glm::quat r;
-				glm::vec3 t;
-				glm::vec3 sk;
-				glm::vec4 per;
-				decompose(p, s, r, t, sk, per);
+				Math::Vector3 const s = parent.get()->getGlobalScale();
 
 				//New localscale, defined as x
 				//x * parent = goal //When we multiply our new localscale with parent it should equal to our goal
 				//x = goal / parent //Which means that we can define x as this
 				//so
-				//_localScale = scale / parent
-				_localScale = scale / Math::Vector3(s.x, s.y, s.z);
+				//localScale = scale / parent
+				localScale = scale / s;
 			}
 		}
 
 		Math::Quaternion Transform::getGlobalRotation()
 		{
-			if (parent == nullptr)
-				return _localRotation;
-
-			//Get global rotation off our matrix
-			glm::mat4 const trans = getTransformationMatrix();
-			glm::quat rotation;
+			if (!parent)
+				return localRotation.get();
 
-			//Unused variables, required for the function
-			glm::vec3 scale;
-			glm::vec3 translation;
-			glm::vec3 skew;
-			glm::vec4 perspective;
-			decompose(trans, scale, rotation, translation, skew, perspective);
-
-			return Math::Quaternion(rotation);
+			TransformStore::updateWorldTRS(index);
+			return Math::Quaternion(TransformStore::worldRotations[index]);
 		}
 
 		void Transform::setGlobalRotation(Math::Quaternion rot)
 		{
-			if (parent == nullptr)
-				_localRotation = rot;
+			if (!parent)
+				localRotation = rot;
 			else
 			{
-				//Throwaway values
-				glm::vec3 scale;
-				glm::vec3 translation;
-				glm::vec3 skew;
-				glm::vec4 perspective;
-
-				//Get parent info
-				glm::mat4 const p = parent->getTransformationMatrix();
-				glm::quat rotation;
-				decompose(p, scale, rotation, translation, skew, perspective);
-
-				glm::mat4 const pr = glm::mat4(rotation);			//Parent rotation
-				glm::mat4 const gl = glm::mat4(rot.getGLMQuat());	//Goal rotation
+				glm::quat const pr = parent.get()->getGlobalRotation().getGLMQuat();	//Parent rotation
+				glm::quat const gl = rot.getGLMQuat();								//Goal rotation
 
 				//Local needs to be x so that
-				//pr * x = gl
-				//So x = gl / pr
-				glm::mat4 const x = gl / pr;
-				decompose(x, scale, rotation, translation, skew, perspective);
-
-				//Local rotation
-				glm::quat const local = rotation;
-				_localRotation = Math::Quaternion(local);
+				//x * pr = gl
+				//So x = gl * inverse(pr)
+				localRotation = Math::Quaternion(gl * glm::inverse(pr));
 			}
 		}
 
 		glm::mat4 Transform::getTransformationMatrix()
 		{
-			//Get parent transformation (recursive)
-			glm::mat4 p = glm::mat4(1.0f);
-			if (parent != nullptr)
-				p *= parent->getTransformationMatrix();
+			TransformStore::updateWorldMatrix(index);
+			return TransformStore::worldMatrices[index];
+		}
+
+		uint32_t Transform::getVersion()
+		{
+			TransformStore::updateWorldMatrix(index);
+			return TransformStore::versions[index];
+		}
 
-			//Get transformation
-			glm::mat4 const t = glm::translate(glm::mat4(1.0f), Vec_Convert3(localPosition.get()));
-			glm::mat4 const r = glm::mat4(localRotation.get().getGLMQuat());
-			glm::mat4 const s = glm::scale(glm::mat4(1.0f), Vec_Convert3(localScale.get()));
+		void Transform::markDirty(uint8_t const flags)
+		{
+			//If every flag was set already, our children have them set too.
+			//The world matrix and world TRS are updated separately, so either one may have been cleared on its own.
+			uint8_t const old = TransformStore::dirty[index].value.fetch_or(flags, std::memory_order_relaxed);
+			if ((old & flags) == flags)
+				return;
 
-			//Apply and return
-			return t * r * s * p;
+			for (size_t i = 0; i < children.size(); i++)
+			{
+				if (Transform* child = children[i].get())
+					child->markDirty(TransformStore::DIRTY_WORLD | TransformStore::DIRTY_WORLD_TRS);
+			}
 		}
 
 		void Transform::rotate(Math::Vector3 axis, float rot)
@@ -265,7 +246,7 @@ namespace Tristeon
 
 		Transform* Transform::getParent() const
 		{
-			return parent;
+			return parent.get();
 		}
 	}
 }
\ No newline at end of file
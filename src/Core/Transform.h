@@ -1,9 +1,11 @@
 ﻿#pragma once
 #include "TObject.h"
+#include "Handle.h"
 #include "Math/Vector3.h"
 #include "Misc/Property.h"
 #include "Editor/TypeRegister.h"
 #include "Misc/vector.h"
+#include "TransformStore.h"
 #include <glm/mat4x4.hpp>
 #include "Math/Quaternion.h"
 
@@ -16,51 +18,64 @@ namespace Tristeon
 		 * Transform is a class used to describe the translation, rotation and scale of an object.
 		 * It's usually contained by GameObject, although its usage is not limited to GameObjects.
 		 * Transform also describes parent-child relationships.
+		 *
+		 * The data of the transform lives in the TransformStore, the transform only holds its index into the store and its hierarchy.
+		 * The local and world matrices and the world position, rotation and scale are cached.
+		 * Changing local values or the parent marks the transform and its children as dirty. The store recalculates dirty world matrices
+		 * once per frame, reading world values in between recalculates them lazily.
+		 * Marking is safe from parallel component updates (CA_OWN_TRANSFORM), reading world values is not and should happen on the main thread.
 		 */
 		class Transform final : public TObject
 		{
 			friend Scenes::SceneManager;
+			friend TransformStore;
 		public:
+			Transform();
 			~Transform();
 
+			Transform(Transform const&) = delete;
+			Transform& operator=(Transform const&) = delete;
+
+			/**
+			 * Returns a handle to this transform. The handle resolves to nullptr once the transform is destroyed.
+			 */
+			Handle<Transform> getHandle() const { return handle; }
+
 			/**
 			 * The global position of this transform.
-			 * Warning: This value is currently not cached and will do multiple matrix calculations,
-			 * and might be an expensive operation depending on the hierarchy depth.
+			 * The value is cached, and only recalculated after this transform or one of its parents has changed.
 			 */
 			Property(Transform, position, Math::Vector3);
 			GetProperty(position) { return getGlobalPosition(); }
 			SetProperty(position) { setGlobalPosition(value); }
 
 			Property(Transform, localPosition, Math::Vector3);
-			GetProperty(localPosition) { return _localPosition; }
-			SetProperty(localPosition) { _localPosition = value; }
+			GetProperty(localPosition) { return TransformStore::localPositions[index]; }
+			SetProperty(localPosition) { TransformStore::localPositions[index] = value; markDirty(TransformStore::DIRTY_ALL); }
 
 			/**
 			 * The global scale of this transform.
-			 * Warning: This value is currently not cached and will do multiple matrix calculations,
-			 * and might be an expensive operation depending on the hierarchy depth.
+			 * The value is cached, and only recalculated after this transform or one of its parents has changed.
 			 */
 			Property(Transform, scale, Math::Vector3);
 			GetProperty(scale) { return getGlobalScale(); }
 			SetProperty(scale) { setGlobalScale(value); }
 
 			Property(Transform, localScale, Math::Vector3);
-			GetProperty(localScale) { return _localScale; }
-			SetProperty(localScale) { _localScale = value; }
+			GetProperty(localScale) { return TransformStore::localScales[index]; }
+			SetProperty(localScale) { TransformStore::localScales[index] = value; markDirty(TransformStore::DIRTY_ALL); }
 
 			/**
 			 * The global rotation of this transform.
-			 * Warning: This value is currently not cached and will do multiple matrix calculations,
-			 * and might be an expensive operation depending on the hierarchy depth.
+			 * The value is cached, and only recalculated after this transform or one of its parents has changed.
 			 */
 			Property(Transform, rotation, Math::Quaternion);
 			GetProperty(rotation) { return getGlobalRotation(); }
 			SetProperty(rotation) { setGlobalRotation(value); }
 
 			Property(Transform, localRotation, Math::Quaternion);
-			GetProperty(localRotation) { return _localRotation; }
-			SetProperty(localRotation) { _localRotation = value; }
+			GetProperty(localRotation) { return TransformStore::localRotations[index]; }
+			SetProperty(localRotation) { TransformStore::localRotations[index] = value; markDirty(TransformStore::DIRTY_ALL); }
 
 			/**
 			 * Sets the parent of this transform. Use nullptr to remove the current parent relationship.
@@ -75,11 +90,17 @@ namespace Tristeon
 
 			/**
 			 * Returns a transformation matrix based on the position, scale, rotation and parent hierarchy of this transform.
-			 * Warning: Transformation matrices aren't cached and might do multiple recursive matrix calculations, 
-			 * which might turn this function into an expensive operation depending on the hierarchy depth.
+			 * The matrix is cached, and only recalculated after this transform or one of its parents has changed.
 			 */
 			glm::mat4 getTransformationMatrix();
 
+			/**
+			 * Returns a counter that changes every time the transformation matrix of this transform changes,
+			 * including changes caused by its parents. Consumers can store the version and skip work while it stays the same.
+			 * The first version of a transform is never 0.
+			 */
+			uint32_t getVersion();
+
 			/**
 			 * Globally rotates around axis [axis] with rotation [rot]
 			 */
@@ -97,14 +118,11 @@ namespace Tristeon
 
 			/**
 			 * Transforms a given point from local to global space.
-			 * Warning: This function will do multiple recursive matrix calculations,
-			 * and might be an expensive operation depending on the hierarchy depth.
 			 */
 			Math::Vector3 transformPoint(Math::Vector3 point);
 			/**
 			 * Transforms a given point from global to local space
-			 * Warning: This function will do multiple recursive matrix calculations,
-			 * and might be an expensive operation depending on the hierarchy depth.
+			 * Warning: This function inverts the transformation matrix, and might be an expensive operation.
 			 */
 			Math::Vector3 inverseTransformPoint(Math::Vector3 point);
 
@@ -138,17 +156,25 @@ namespace Tristeon
 			Math::Quaternion getGlobalRotation();
 			void setGlobalRotation(Math::Quaternion rot);
 
-			Math::Vector3 _localPosition = { 0, 0, 0 };
-			Math::Vector3 _localScale = { 1, 1, 1 };
-			Math::Quaternion _localRotation = {};
+			/**
+			 * Marks the given cached values as dirty, and the world values of all our children.
+			 * Stops early if our world matrix was dirty already, because the children are guaranteed to be dirty then too.
+			 */
+			void markDirty(uint8_t flags);
+
+			/**
+			 * Our slot in the TransformStore. Updated by the store when it's reordered.
+			 */
+			uint32_t index;
 
 			/**
 			 * The id of the parent. Used to assign parent child relationships through a lookup in the scene.
 			 */
-			std::string parentID = "null";
+			uint64_t parentID = invalidInstanceID;
 
-			Transform* parent = nullptr;
-			Tristeon::vector<Transform*> children;
+			Handle<Transform> handle;
+			Handle<Transform> parent;
+			Tristeon::vector<Handle<Transform>> children;
 
 			REGISTER_TYPE_H(Transform)
 		};
@@ -0,0 +1,315 @@
+﻿#include "TransformStore.h"
+#include "Transform.h"
+#include "Math/Simd.h"
+#include "Jobs/JobSystem.h"
+#include <glm/gtx/matrix_decompose.hpp>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		std::vector<Math::Vector3> TransformStore::localPositions;
+		std::vector<Math::Quaternion> TransformStore::localRotations;
+		std::vector<Math::Vector3> TransformStore::localScales;
+		std::vector<glm::mat4> TransformStore::localMatrices;
+		std::vector<glm::mat4> TransformStore::worldMatrices;
+		std::vector<glm::quat> TransformStore::worldRotations;
+		std::vector<glm::vec3> TransformStore::worldScales;
+		std::vector<bool> TransformStore::skewed;
+		std::vector<uint32_t> TransformStore::parents;
+		std::vector<uint32_t> TransformStore::versions;
+		std::vector<TransformStore::DirtyFlags> TransformStore::dirty;
+		std::vector<Transform*> TransformStore::owners;
+		std::vector<size_t> TransformStore::levelOffsets = { 0 };
+		const uint32_t TransformStore::noParent;
+		bool TransformStore::sorted = true;
+		size_t TransformStore::destroyedCount = 0;
+
+		void TransformStore::update()
+		{
+			if (!sorted)
+				sort();
+
+			forRange(0, owners.size(), updateLocalMatrices);
+
+			//Every level only reads the world matrices of the level before it
+			for (size_t level = 0; level + 1 < levelOffsets.size(); level++)
+				forRange(levelOffsets[level], levelOffsets[level + 1], updateWorldMatrices);
+			updateWorldMatrices(levelOffsets.back(), owners.size());
+		}
+
+		void TransformStore::updateLocalMatrices(size_t const begin, size_t const end)
+		{
+			//Compose every run of dirty transforms in a single batch
+			size_t first = begin;
+			while (first < end)
+			{
+				if ((dirty[first].value.load(std::memory_order_relaxed) & DIRTY_LOCAL) == 0)
+				{
+					first++;
+					continue;
+				}
+
+				size_t last = first + 1;
+				while (last < end && (dirty[last].value.load(std::memory_order_relaxed) & DIRTY_LOCAL) != 0)
+					last++;
+
+				Math::Simd::composeTransforms(
+					reinterpret_cast<glm::vec3 const*>(&localPositions[first]),
+					reinterpret_cast<glm::quat const*>(&localRotations[first]),
+					reinterpret_cast<glm::vec3 const*>(&localScales[first]),
+					&localMatrices[first], last - first);
+
+				for (size_t i = first; i < last; i++)
+					dirty[i].value.fetch_and(uint8_t(~DIRTY_LOCAL), std::memory_order_relaxed);
+				first = last;
+			}
+		}
+
+		void TransformStore::updateWorldMatrices(size_t const begin, size_t const end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				if ((dirty[i].value.load(std::memory_order_relaxed) & DIRTY_WORLD) == 0)
+					continue;
+
+				if (parents[i] == noParent)
+					worldMatrices[i] = localMatrices[i];
+				else
+					Math::Simd::multiplyMatrices(&localMatrices[i], &worldMatrices[parents[i]], &worldMatrices[i], 1);
+				versions[i]++;
+				dirty[i].value.fetch_and(uint8_t(~DIRTY_WORLD), std::memory_order_relaxed);
+			}
+		}
+
+		template <typename F>
+		void TransformStore::forRange(size_t const begin, size_t const end, F function)
+		{
+			//Not worth the scheduling overhead if everything fits in a single job
+			if (end - begin <= parallelBatchSize)
+			{
+				function(begin, end);
+				return;
+			}
+
+			Jobs::JobSystem::parallelFor(end - begin, parallelBatchSize, [&](size_t const first, size_t const last)
+			{
+				function(begin + first, begin + last);
+			});
+		}
+
+		uint32_t TransformStore::create(Transform* owner)
+		{
+			//Don't let destroyed slots pile up if the store isn't being updated
+			if (destroyedCount > 64 && destroyedCount > owners.size() / 2)
+				sort();
+
+			localPositions.push_back(Math::Vector3(0, 0, 0));
+			localRotations.push_back(Math::Quaternion());
+			localScales.push_back(Math::Vector3(1, 1, 1));
+			localMatrices.push_back(glm::mat4(1.0f));
+			worldMatrices.push_back(glm::mat4(1.0f));
+			worldRotations.push_back(glm::quat(1, 0, 0, 0));
+			worldScales.push_back(glm::vec3(1.0f));
+			skewed.push_back(false);
+			parents.push_back(noParent);
+			versions.push_back(0);
+			dirty.push_back(DirtyFlags(DIRTY_ALL));
+			owners.push_back(owner);
+
+			//New roots end up behind the deepest level
+			sorted = false;
+			return uint32_t(owners.size() - 1);
+		}
+
+		void TransformStore::destroy(uint32_t const index)
+		{
+			owners[index] = nullptr;
+			parents[index] = noParent;
+			dirty[index].value.store(0, std::memory_order_relaxed);
+			destroyedCount++;
+			sorted = false;
+		}
+
+		void TransformStore::setParent(uint32_t const index, uint32_t const parent)
+		{
+			//The depth of the transform and its children might have changed
+			parents[index] = parent;
+			sorted = false;
+		}
+
+		void TransformStore::updateWorldMatrix(uint32_t const index)
+		{
+			uint8_t const flags = dirty[index].value.load(std::memory_order_relaxed);
+			if ((flags & DIRTY_WORLD) == 0)
+				return;
+
+			if (flags & DIRTY_LOCAL)
+			{
+				Math::Simd::composeTransforms(
+					reinterpret_cast<glm::vec3 const*>(&localPositions[index]),
+					reinterpret_cast<glm::quat const*>(&localRotations[index]),
+					reinterpret_cast<glm::vec3 const*>(&localScales[index]),
+					&localMatrices[index], 1);
+			}
+
+			uint32_t const parent = parents[index];
+			if (parent == noParent)
+			{
+				worldMatrices[index] = localMatrices[index];
+			}
+			else
+			{
+				updateWorldMatrix(parent);
+				Math::Simd::multiplyMatrices(&localMatrices[index], &worldMatrices[parent], &worldMatrices[index], 1);
+			}
+			versions[index]++;
+
+			dirty[index].value.fetch_and(uint8_t(~(DIRTY_LOCAL | DIRTY_WORLD)), std::memory_order_relaxed);
+		}
+
+		void TransformStore::updateWorldTRS(uint32_t const index)
+		{
+			if ((dirty[index].value.load(std::memory_order_relaxed) & DIRTY_WORLD_TRS) == 0)
+				return;
+
+			glm::quat const localRotation = localRotations[index].getGLMQuat();
+			glm::vec3 const localScale = localScales[index];
+
+			uint32_t const parent = parents[index];
+			if (parent == noParent)
+			{
+				worldRotations[index] = localRotation;
+				worldScales[index] = localScale;
+				skewed[index] = false;
+			}
+			else
+			{
+				updateWorldTRS(parent);
+
+				//The linear part of our world matrix is R * S * parentR * parentS.
+				//S and parentR commute if our scale is uniform or if the parent isn't rotated, which makes it (R * parentR) * (S * parentS).
+				glm::quat const& parentRotation = worldRotations[parent];
+				bool const uniform = localScale.x == localScale.y && localScale.y == localScale.z;
+				bool const parentRotated = parentRotation != glm::quat(1, 0, 0, 0);
+
+				if (!skewed[parent] && (uniform || !parentRotated))
+				{
+					worldRotations[index] = localRotation * parentRotation;
+					worldScales[index] = localScale * worldScales[parent];
+					skewed[index] = false;
+				}
+				else
+				{
+					updateWorldMatrix(index);
+
+					//Unused variables but required in the function, the position is read directly from the matrix
+					glm::vec3 translation;
+					glm::vec3 skew;
+					glm::vec4 perspective;
+					decompose(worldMatrices[index], worldScales[index], worldRotations[index], translation, skew, perspective);
+					skewed[index] = true;
+				}
+			}
+
+			dirty[index].value.fetch_and(uint8_t(~DIRTY_WORLD_TRS), std::memory_order_relaxed);
+		}
+
+		void TransformStore::sort()
+		{
+			size_t const count = owners.size();
+
+			//Group the children of every transform (counting sort on the parent index)
+			std::vector<uint32_t> childOffsets(count + 1, 0);
+			for (size_t i = 0; i < count; i++)
+			{
+				if (owners[i] != nullptr && parents[i] != noParent)
+					childOffsets[parents[i] + 1]++;
+			}
+			for (size_t i = 0; i < count; i++)
+				childOffsets[i + 1] += childOffsets[i];
+
+			std::vector<uint32_t> childList(childOffsets[count]);
+			std::vector<uint32_t> fill(childOffsets.begin(), childOffsets.end() - 1);
+			for (size_t i = 0; i < count; i++)
+			{
+				if (owners[i] != nullptr && parents[i] != noParent)
+					childList[fill[parents[i]]++] = uint32_t(i);
+			}
+
+			//Breadth first from the roots, level by level
+			std::vector<uint32_t> order;
+			order.reserve(count - destroyedCount);
+			for (size_t i = 0; i < count; i++)
+			{
+				if (owners[i] != nullptr && parents[i] == noParent)
+					order.push_back(uint32_t(i));
+			}
+
+			levelOffsets.clear();
+			size_t levelBegin = 0;
+			while (levelBegin < order.size())
+			{
+				size_t const levelEnd = order.size();
+				levelOffsets.push_back(levelBegin);
+				for (size_t i = levelBegin; i < levelEnd; i++)
+				{
+					for (uint32_t c = childOffsets[order[i]]; c < childOffsets[order[i] + 1]; c++)
+						order.push_back(childList[c]);
+				}
+				levelBegin = levelEnd;
+			}
+			levelOffsets.push_back(order.size());
+
+			//Transforms in a parent loop aren't reachable from any root. Keep them rather than losing them, their order doesn't matter.
+			if (order.size() != count - destroyedCount)
+			{
+				std::vector<bool> visited(count, false);
+				for (uint32_t const i : order)
+					visited[i] = true;
+				for (size_t i = 0; i < count; i++)
+				{
+					if (owners[i] != nullptr && !visited[i])
+						order.push_back(uint32_t(i));
+				}
+			}
+
+			std::vector<uint32_t> newIndices(count, noParent);
+			for (size_t i = 0; i < order.size(); i++)
+				newIndices[order[i]] = uint32_t(i);
+
+			reorder(localPositions, order);
+			reorder(localRotations, order);
+			reorder(localScales, order);
+			reorder(localMatrices, order);
+			reorder(worldMatrices, order);
+			reorder(worldRotations, order);
+			reorder(worldScales, order);
+			reorder(skewed, order);
+			reorder(parents, order);
+			reorder(versions, order);
+			reorder(dirty, order);
+			reorder(owners, order);
+
+			for (size_t i = 0; i < order.size(); i++)
+			{
+				if (parents[i] != noParent)
+					parents[i] = newIndices[parents[i]];
+				owners[i]->index = uint32_t(i);
+			}
+
+			destroyedCount = 0;
+			sorted = true;
+		}
+
+		template <typename T>
+		void TransformStore::reorder(std::vector<T>& data, std::vector<uint32_t> const& order)
+		{
+			std::vector<T> result;
+			result.reserve(order.size());
+			for (uint32_t const i : order)
+				result.push_back(data[i]);
+			data.swap(result);
+		}
+	}
+}
@@ -0,0 +1,158 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <glm/mat4x4.hpp>
+#include "Math/Vector3.h"
+#include "Math/Quaternion.h"
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		class Transform;
+
+		/**
+		 * TransformStore holds the data of every Transform as a structure of arrays: local position/rotation/scale,
+		 * local and world matrices, cached world rotation/scale, parent indices, change versions and dirty flags.
+		 * Transform itself is a thin wrapper around an index into the store.
+		 *
+		 * The store is sorted breadth first, so every depth level of the hierarchy is a contiguous range and parents precede their children.
+		 * update() calculates the world matrices level by level, and splits each level across the JobSystem's workers.
+		 * Hierarchy changes (creating, destroying or reparenting transforms) flag the store, and the order is restored at the start of the next update().
+		 *
+		 * Transforms are created, destroyed and reparented on the main thread.
+		 * The local values of different transforms can be written in parallel, see Transform.
+		 */
+		class TransformStore final
+		{
+			friend Transform;
+		public:
+			/**
+			 * Recalculates every dirty local and world matrix in parallel. Called once per frame, before rendering.
+			 * Must be called from the main thread.
+			 */
+			static void update();
+
+			/**
+			 * Returns the amount of slots in the store, including destroyed transforms that haven't been compacted yet
+			 */
+			static size_t size() { return owners.size(); }
+		private:
+			static const uint32_t noParent = UINT32_MAX;
+
+			/**
+			 * Describes which cached values of a transform are out of date. Used as bit flags.
+			 */
+			enum Dirty : uint8_t
+			{
+				DIRTY_LOCAL = 1 << 0,
+				DIRTY_WORLD = 1 << 1,
+				DIRTY_WORLD_TRS = 1 << 2,
+				DIRTY_ALL = DIRTY_LOCAL | DIRTY_WORLD | DIRTY_WORLD_TRS
+			};
+
+			/**
+			 * std::atomic can't be stored in a vector directly because it isn't copyable.
+			 * Copies only happen while the store is resized or sorted, which never happens in parallel with other accesses.
+			 */
+			struct DirtyFlags
+			{
+				std::atomic<uint8_t> value;
+
+				DirtyFlags(uint8_t const flags = DIRTY_ALL) : value(flags) { }
+				DirtyFlags(DirtyFlags const& other) : value(other.value.load(std::memory_order_relaxed)) { }
+				DirtyFlags& operator=(DirtyFlags const& other) { value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed); return *this; }
+			};
+
+			/**
+			 * Adds a transform without a parent to the end of the store, and returns its index
+			 */
+			static uint32_t create(Transform* owner);
+			/**
+			 * Frees the slot of the given transform. The slot is removed when the store is sorted.
+			 */
+			static void destroy(uint32_t index);
+			/**
+			 * Sets the parent index of the given transform, parent may be noParent
+			 */
+			static void setParent(uint32_t index, uint32_t parent);
+
+			/**
+			 * Recalculates the world matrix of a single transform and its parents if they're dirty.
+			 * Used to read up to date values in between updates.
+			 */
+			static void updateWorldMatrix(uint32_t index);
+			/**
+			 * Calculates the world rotation and scale of the transform (and its parents) if they're dirty.
+			 * They're composed from the local values along the parent chain, without building matrices.
+			 * Hierarchies with non-uniform scale under a rotated parent are skewed, for those the world matrix is decomposed instead.
+			 */
+			static void updateWorldTRS(uint32_t index);
+
+			/**
+			 * Reorders the store so that parents precede children, and removes the slots of destroyed transforms.
+			 * Updates the index of every transform that moved.
+			 */
+			static void sort();
+
+			/**
+			 * Composes the local matrices of the dirty transforms in [begin, end)
+			 */
+			static void updateLocalMatrices(size_t begin, size_t end);
+			/**
+			 * Calculates the world matrices of the dirty transforms in [begin, end). The world matrices of their parents must be up to date.
+			 */
+			static void updateWorldMatrices(size_t begin, size_t end);
+			/**
+			 * Calls function(begin, end) over [begin, end), split into batches across the JobSystem if the range is large enough
+			 */
+			template <typename F>
+			static void forRange(size_t begin, size_t end, F function);
+
+			/**
+			 * The amount of transforms that is updated by a single job
+			 */
+			static const size_t parallelBatchSize = 256;
+
+			/**
+			 * Gathers the elements of data in the given order
+			 */
+			template <typename T>
+			static void reorder(std::vector<T>& data, std::vector<uint32_t> const& order);
+
+			static std::vector<Math::Vector3> localPositions;
+			static std::vector<Math::Quaternion> localRotations;
+			static std::vector<Math::Vector3> localScales;
+			static std::vector<glm::mat4> localMatrices;
+			static std::vector<glm::mat4> worldMatrices;
+			static std::vector<glm::quat> worldRotations;
+			static std::vector<glm::vec3> worldScales;
+			/**
+			 * True if the world matrix of the transform contains skew, which means that its world rotation and scale are approximations
+			 */
+			static std::vector<bool> skewed;
+			static std::vector<uint32_t> parents;
+			/**
+			 * Incremented every time the world matrix of a transform is recalculated
+			 */
+			static std::vector<uint32_t> versions;
+			static std::vector<DirtyFlags> dirty;
+			/**
+			 * The transform that owns each slot, nullptr for destroyed transforms
+			 */
+			static std::vector<Transform*> owners;
+
+			/**
+			 * levelOffsets[i] is the first slot of depth level i. The last element is the end of the last level.
+			 * Slots past the end are in a parent loop and are updated serially.
+			 */
+			static std::vector<size_t> levelOffsets;
+			/**
+			 * False if the hierarchy has changed since the last sort, or if there are destroyed slots left
+			 */
+			static bool sorted;
+			static size_t destroyedCount;
+		};
+	}
+}
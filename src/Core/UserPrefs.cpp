@@ -1,4 +1,9 @@
 ﻿#include "UserPrefs.h"
+#include "Misc/Console.h"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
 
 namespace Tristeon
 {
@@ -56,8 +61,60 @@ namespace Tristeon
 			sUserPrefs["RENDERTECHNIQUE"] = "FORWARD";
 
 			bUserPrefs["FULLSCREEN"] = false;
+			bUserPrefs["DETERMINISTICUPDATE"] = false;
+			bUserPrefs["RENDERTHREAD"] = false;
 			iUserPrefs["SCREENWIDTH"] = 1920;
 			iUserPrefs["SCREENHEIGHT"] = 980;
+			fUserPrefs["FIXEDDELTATIME"] = 1.0f / 50.0f;
+			iUserPrefs["MAXFIXEDSTEPS"] = 5;
+			//The amount of job worker threads, 0 creates one for every hardware thread except the main thread
+			iUserPrefs["JOBWORKERS"] = 0;
+
+			//Headless engines run without a window, input or renderer
+			bUserPrefs["HEADLESS"] = false;
+			fUserPrefs["HEADLESSTICKRATE"] = 60;
+			iUserPrefs["HEADLESSFRAMES"] = 0;
+
+			//Profiler captures are only recorded in builds with TRISTEON_PROFILER
+			sUserPrefs["PROFILEOUTPUT"] = "";
+			iUserPrefs["PROFILEFRAMES"] = 0;
+
+			//Frames that take longer than the threshold (in milliseconds) are counted as hitches
+			fUserPrefs["FRAMEHITCHTHRESHOLD"] = 1000.0f / 30.0f;
+			sUserPrefs["FRAMESTATSOUTPUT"] = "";
+		}
+
+		void UserPrefs::readArguments(int argc, char** argv)
+		{
+			for (int i = 1; i < argc; i++)
+			{
+				std::string argument = argv[i];
+				if (argument.compare(0, 2, "--") != 0)
+					continue;
+
+				size_t const separator = argument.find('=');
+				std::string name = argument.substr(2, separator == std::string::npos ? std::string::npos : separator - 2);
+				std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+				std::string const value = separator == std::string::npos ? "" : argument.substr(separator + 1);
+
+				try
+				{
+					if (hasBool(name))
+						bUserPrefs[name] = value.empty() || value == "1" || value == "true";
+					else if (hasInt(name))
+						iUserPrefs[name] = std::stoi(value);
+					else if (hasFloat(name))
+						fUserPrefs[name] = std::stof(value);
+					else if (hasString(name))
+						sUserPrefs[name] = value;
+					else
+						Misc::Console::warning("Unknown user pref " + name + " passed as argument, it will be ignored");
+				}
+				catch (std::logic_error const&)
+				{
+					Misc::Console::warning("Invalid value " + value + " passed for user pref " + name + ", it will be ignored");
+				}
+			}
 		}
 	}
 }
\ No newline at end of file
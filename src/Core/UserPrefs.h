@@ -48,6 +48,11 @@ namespace Tristeon
 			static bool hasFloat(const std::string& pName);
 		private:
 			static void readPrefs();
+			/**
+			 * Overrides prefs with the command line arguments. Arguments are formatted as --NAME=VALUE, or --NAME to enable a bool.
+			 * Only prefs that are already defined can be overridden, the value is parsed as the type the pref was defined with.
+			 */
+			static void readArguments(int argc, char** argv);
 			static std::map<std::string, int> iUserPrefs;
 			static std::map<std::string, std::string> sUserPrefs;
 			static std::map<std::string, bool> bUserPrefs;
@@ -1,4 +1,5 @@
 ﻿#include "ImageBatch.h"
+#include "Misc/Profiler.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -29,6 +30,7 @@ namespace Tristeon
 
 		bool ImageBatch::load(std::string path)
 		{
+			TRISTEON_PROFILE_FUNCTION();
 			//Clear old cached image
 			if (cachedImages.find(path) != cachedImages.end())
 				stbi_image_free(cachedImages[path].pixels);
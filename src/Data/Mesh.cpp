@@ -10,6 +10,7 @@
 
 #include "Misc/Console.h"
 #include "Core/UserPrefs.h"
+#include "Misc/Profiler.h"
 
 namespace Tristeon
 {
@@ -24,6 +25,7 @@ namespace Tristeon
 
 		void Mesh::load(std::string filePath)
 		{
+			TRISTEON_PROFILE_FUNCTION();
 			Assimp::Importer imp;
 
 			//Postprocessing
@@ -42,7 +42,7 @@ nlohmann::json EditorNodeTree::getData()
 	return output;
 }
 
-EditorNode* EditorNodeTree::findNodeByInstanceID(std::string nodeInstanceID)
+EditorNode* EditorNodeTree::findNodeByInstanceID(uint64_t nodeInstanceID)
 {
 	for (int i = 0; i < nodes.size(); ++i)
 	{
@@ -59,7 +59,7 @@ void EditorNodeTree::createParentalBonds()
 	{
 		const auto parent = nodes[i]->connectedGameObject->transform.get()->getParent();
 		if (parent == nullptr) continue;
-		const std::string nodeInstanceID = parent->getInstanceID();
+		const uint64_t nodeInstanceID = parent->getInstanceID();
 		nodes[i]->move(findNodeByInstanceID(nodeInstanceID));
 	}
 }
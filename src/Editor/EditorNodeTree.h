@@ -16,7 +16,7 @@ namespace Tristeon
 			std::vector<std::unique_ptr<EditorNode>> nodes;
 			void load(nlohmann::json nodeTree);
 			nlohmann::json getData();
-			EditorNode* findNodeByInstanceID(std::string nodeInstanceID);
+			EditorNode* findNodeByInstanceID(uint64_t nodeInstanceID);
 			void createParentalBonds();
 			void removeNode(EditorNode* node);
 		};
@@ -44,6 +44,9 @@ namespace Tristeon
 
 	TristeonEditor::~TristeonEditor()
 	{
+		for (Core::MessageBus::Subscription const& subscription : subscriptions)
+			Core::MessageBus::unsubscribeFromMessage(subscription);
+
 		Core::MessageBus::sendMessage(Core::Message(Core::MT_RENDERINGCOMPONENT_DEREGISTER, renderable));
 		delete renderable;
 
@@ -189,13 +192,13 @@ namespace Tristeon
 	void TristeonEditor::setupCallbacks()
 	{
 		//Subscribe to render callback
-		Core::MessageBus::subscribeToMessage(Core::MT_PRERENDER, std::bind(&TristeonEditor::onGui, this));
-		Core::MessageBus::subscribeToMessage(Core::MT_SHARE_DATA, [&](Core::Message msg)
+		subscriptions.push_back(Core::MessageBus::subscribeToMessage(Core::MT_PRERENDER, std::bind(&TristeonEditor::onGui, this)));
+		subscriptions.push_back(Core::MessageBus::subscribeToMessage(Core::MT_SHARE_DATA, [&](Core::Message msg)
 		{
 			Core::Rendering::Vulkan::EditorData* data = dynamic_cast<Core::Rendering::Vulkan::EditorData*>(msg.userData);
 			if (data != nullptr)
 				this->editorCamera = data;
-		});
+		}));
 
 		renderable = new Core::Rendering::UIRenderable();
 		renderable->onRender += [&]() { render(); };
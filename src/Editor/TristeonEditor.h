@@ -63,6 +63,7 @@ namespace Tristeon
 
 			//Rendering
 			Core::Rendering::UIRenderable* renderable = nullptr;
+			std::vector<Core::MessageBus::Subscription> subscriptions;
 			vk::CommandBuffer cmd;
 			vk::Device vkDevice;
 
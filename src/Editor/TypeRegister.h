@@ -4,7 +4,25 @@
 #include "Misc/Console.h"
 #include "XPlatform/typename.h"
 
-template <typename T> std::unique_ptr<IntrospectionInterface> CreateInstance() { return std::make_unique<T>(); }
+/**
+ * \brief Allocates the instances created by the typeregister. Can be specialized to control where instances of a type are allocated.
+ */
+template <typename T, typename = void>
+struct InstanceAllocator
+{
+	static T* create() { return new T(); }
+};
+
+/**
+ * \brief Called by DerivedRegister when a type gets registered. Can be specialized to record additional information about a type.
+ */
+template <typename T, typename = void>
+struct TypeRegisterCallback
+{
+	static void onRegister() { }
+};
+
+template <typename T> std::unique_ptr<IntrospectionInterface> CreateInstance() { return std::unique_ptr<IntrospectionInterface>(InstanceAllocator<T>::create()); }
 
 /**
  * \brief The typeregister pretty much is a map that is used to create instances of registered types
@@ -47,6 +65,7 @@ struct DerivedRegister : TypeRegister
 	DerivedRegister()
 	{
 		getMap()->emplace(TRISTEON_TYPENAME(T), &CreateInstance<T>);
+		TypeRegisterCallback<T>::onRegister();
 	}
 };
 
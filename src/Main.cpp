@@ -69,7 +69,7 @@ int main(int argc, char** argv)
 	FreeConsole();
 #endif
 
-	Core::Engine engine{};
+	Core::Engine engine{ argc, argv };
 
 #ifdef TRISTEON_EDITOR
 	Editor::TristeonEditor editor(&engine);
@@ -8,32 +8,22 @@ namespace Tristeon
 {
 	namespace Math
 	{
-		REGISTER_TYPE_CPP(Quaternion)
-
-		Quaternion::Quaternion()
-		{
-			quaternion = glm::quat();
-		}
-
-		Quaternion::Quaternion(glm::quat glmQuat)
+		Quaternion::Quaternion() : x(0), y(0), z(0), w(1)
 		{
-			quaternion = glmQuat;
 		}
 
-		Quaternion::Quaternion(Vector3 vector)
+		Quaternion::Quaternion(Vector3 vector) : Quaternion(glm::quat(glm::radians(glm::vec3(vector))))
 		{
-			quaternion = glm::quat(glm::radians(glm::vec3(Vec_Convert3(vector))));
 		}
 
-		Quaternion::Quaternion(float x, float y, float z, float w)
+		Quaternion::Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w)
 		{
-			quaternion = glm::quat(x, y, z, w);
 		}
 
 		float Quaternion::operator[](int index) const
 		{
 			Misc::Console::t_assert(index <= 3, "Quaternion [] operator tried to access a value higher than 3");
-			return quaternion[index];
+			return (&x)[index];
 		}
 
 		bool Quaternion::operator!=(Quaternion other) const
@@ -52,26 +42,17 @@ namespace Tristeon
 
 		Quaternion Quaternion::operator*(Quaternion other) const
 		{
-			return Quaternion(quaternion * other.quaternion);
-		}
-
-		Quaternion Quaternion::operator=(Quaternion other)
-		{
-			quaternion.x = other.x;
-			quaternion.y = other.y;
-			quaternion.z = other.z;
-			quaternion.w = other.w;
-			return *this;
+			return Quaternion(getGLMQuat() * other.getGLMQuat());
 		}
 
 		void Quaternion::operator*=(Quaternion other)
 		{
-			quaternion *= other.quaternion;
+			*this = *this * other;
 		}
 
 		Quaternion Quaternion::euler(Vector3 angles)
 		{
-			return Quaternion(glm::quat(radians(glm::vec3(Vec_Convert3(angles)))));
+			return Quaternion(glm::quat(radians(glm::vec3(angles))));
 		}
 
 		Quaternion Quaternion::euler(float x, float y, float z)
@@ -81,68 +62,61 @@ namespace Tristeon
 
 		Quaternion Quaternion::slerp(Quaternion start, Quaternion end, float interval)
 		{
-			return Quaternion(glm::slerp(start.quaternion, end.quaternion, interval));
+			return Quaternion(glm::slerp(start.getGLMQuat(), end.getGLMQuat(), interval));
 		}
 
 		Quaternion Quaternion::lerp(Quaternion start, Quaternion end, float interval)
 		{
-			return Quaternion(glm::lerp(start.quaternion, end.quaternion, interval));
+			return Quaternion(glm::lerp(start.getGLMQuat(), end.getGLMQuat(), interval));
 		}
 
 		Quaternion Quaternion::lookRotation(Vector3 position, Vector3 target)
 		{
-			return Quaternion(glm::lookAt(Vec_Convert3(position), Vec_Convert3(target), glm::vec3(0, 1, 0)));
+			return Quaternion(glm::quat(glm::lookAt(glm::vec3(position), glm::vec3(target), glm::vec3(0, 1, 0))));
 		}
 
 		Quaternion Quaternion::inverse(Quaternion quat)
 		{
-			return Quaternion(glm::inverse(quat.quaternion));
+			return Quaternion(glm::inverse(quat.getGLMQuat()));
 		}
 
 		Quaternion Quaternion::rotate(Vector3 axis, float amount)
 		{
-			quaternion = glm::rotate(quaternion, glm::radians(amount), Vec_Convert3(axis));
+			*this = Quaternion(glm::rotate(getGLMQuat(), glm::radians(amount), glm::vec3(axis)));
 			return *this;
 		}
 
 		void Quaternion::lookAt(Vector3 eye, Vector3 target)
 		{
-			quaternion = glm::quat(glm::lookAt(Vec_Convert3(eye), Vec_Convert3(target), glm::vec3(0, 1, 0)));
+			*this = Quaternion(glm::quat(glm::lookAt(glm::vec3(eye), glm::vec3(target), glm::vec3(0, 1, 0))));
 		}
 
 		Vector3 Quaternion::eulerAngles() const
 		{
-			return Vec_Convert3(degrees(glm::eulerAngles(quaternion)));
-		}
-
-		glm::quat Quaternion::getGLMQuat() const
-		{
-			return quaternion;
+			return Vector3(degrees(glm::eulerAngles(getGLMQuat())));
 		}
 
-		nlohmann::json Quaternion::serialize()
+		void to_json(nlohmann::json& j, const Quaternion& p)
 		{
-			nlohmann::json j;
+			j = nlohmann::json();
 			j["typeID"] = TRISTEON_TYPENAME(Quaternion);
-			j["x"] = x.get();
-			j["y"] = y.get();
-			j["z"] = z.get();
-			j["w"] = w.get();
-			return j;
+			j["x"] = p.x;
+			j["y"] = p.y;
+			j["z"] = p.z;
+			j["w"] = p.w;
 		}
 
-		void Quaternion::deserialize(nlohmann::json json)
+		void from_json(const nlohmann::json& j, Quaternion& p)
 		{
-			x = (float) json["x"];
-			y = (float) json["y"];
-			z = (float) json["z"];
-			w = (float) json["w"];
+			p.x = j["x"];
+			p.y = j["y"];
+			p.z = j["z"];
+			p.w = j["w"];
 		}
 
 		Vector3 operator*(Quaternion quaternion, Vector3 vec)
 		{
-			const glm::vec3 output = quaternion.getGLMQuat() * glm::vec3(vec.x, vec.y, vec.z);
-			return Vector3(output.x, output.y, output.z);
+			return Vector3(quaternion.getGLMQuat() * glm::vec3(vec));
 		}
 
 		Vector3 operator*(Vector3 vec, Quaternion quaternion)
@@ -1,25 +1,24 @@
 ﻿#pragma once
 #include <glm/gtc/quaternion.hpp>
 #include <glm/glm.hpp>
+#include <type_traits>
 
-#include <misc/Property.h>
-#include "Core/TObject.h"
-#include <Editor/TypeRegister.h>
 #include "Vector3.h"
+#include "Editor/json.hpp"
 
 namespace Tristeon
 {
 	namespace Math
 	{
-		class Vector3;
-
 		/**
 		 *  Quaternion dsescribes a 3D rotation. This way of describing 3D rotation prevents issues that are experienced with a euler approach like gimbal lock.
 		 *
 		 *  Unless if you are well experienced with Quaternions, it is recommended to use the functionality provided through class and static methods,
 		 *  rather than modifying the components of the quaternion directly.
+		 *
+		 *  Quaternion is a plain value type with the same layout as glm::quat, and converts to and from glm::quat implicitly.
 		 */
-		class Quaternion : public Core::TObject
+		struct Quaternion
 		{
 		public:
 			/**
@@ -29,7 +28,7 @@ namespace Tristeon
 			/**
 			 * Creates a quaternion from the given glm quat
 			 */
-			Quaternion(glm::quat glmQuat);
+			Quaternion(glm::quat const& glmQuat) : x(glmQuat.x), y(glmQuat.y), z(glmQuat.z), w(glmQuat.w) { }
 			/**
 			 * Creates a quaternion from the given euler angles
 			 * \param vector The euler angles described as vector
@@ -40,6 +39,11 @@ namespace Tristeon
 			 */
 			Quaternion(float x, float y, float z, float w);
 
+			/**
+			 * Converts the quaternion to a glm quaternion
+			 */
+			operator glm::quat() const { return getGLMQuat(); }
+
 			/**
 			 * Gets the quaternion axis based on the given index
 			 */
@@ -47,13 +51,12 @@ namespace Tristeon
 			bool operator!=(Quaternion other) const;
 			bool operator==(Quaternion other) const;
 			Quaternion operator*(Quaternion other) const;
-			Quaternion operator=(Quaternion other);
 			void operator*=(Quaternion other);
 
-			PropertyNestedValue(Quaternion, w, float, quaternion.w);
-			PropertyNestedValue(Quaternion, x, float, quaternion.x);
-			PropertyNestedValue(Quaternion, y, float, quaternion.y);
-			PropertyNestedValue(Quaternion, z, float, quaternion.z);
+			float x;
+			float y;
+			float z;
+			float w;
 
 			/**
 			 * Creates a new quaternion based on the given euler angles (degrees)
@@ -107,15 +110,18 @@ namespace Tristeon
 			/**
 			 * Gets the GLM quaternion
 			 */
-			glm::quat getGLMQuat() const;
-
-			nlohmann::json serialize() override;
-			void deserialize(nlohmann::json json) override;
-		private:
-			glm::quat quaternion;
-			REGISTER_TYPE_H(Quaternion)
+			glm::quat getGLMQuat() const { return glm::quat(w, x, y, z); }
 		};
 
+		static_assert(std::is_trivially_copyable<Quaternion>::value && std::is_standard_layout<Quaternion>::value, "Quaternion must be a plain value type!");
+		static_assert(sizeof(Quaternion) == sizeof(glm::quat), "Quaternion must have the same layout as glm::quat!");
+
+		/**
+		 * Json serialization of Quaternion, also used by nlohmann::json for maps/vectors of Quaternion
+		 */
+		void to_json(nlohmann::json& j, const Quaternion& p);
+		void from_json(const nlohmann::json& j, Quaternion& p);
+
 		Vector3 operator*(Quaternion quaternion, Vector3 vec);
 		Vector3 operator*(Vector3 vec, Quaternion quaternion);
 	}
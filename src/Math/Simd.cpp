@@ -0,0 +1,445 @@
+﻿#include "Simd.h"
+#include <algorithm>
+#include <glm/common.hpp>
+
+#if defined(TRISTEON_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(TRISTEON_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Tristeon
+{
+	namespace Math
+	{
+		namespace Simd
+		{
+			namespace
+			{
+#if defined(TRISTEON_SIMD_SSE2)
+				/**
+				 * 4 floats per register. The kernels below are written against this interface so that they can run on either register width.
+				 * Shuffles and unpacks operate within 128 bit lanes, the AVX version simply processes two groups of 4 side by side.
+				 */
+				struct Sse
+				{
+					typedef __m128 Register;
+					static size_t const width = 4;
+
+					static Register set1(float const value) { return _mm_set1_ps(value); }
+					static Register add(Register const a, Register const b) { return _mm_add_ps(a, b); }
+					static Register sub(Register const a, Register const b) { return _mm_sub_ps(a, b); }
+					static Register mul(Register const a, Register const b) { return _mm_mul_ps(a, b); }
+					static Register madd(Register const a, Register const b, Register const c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+					template <int Mask> static Register shuffle(Register const a, Register const b) { return _mm_shuffle_ps(a, b, Mask); }
+					static Register unpacklo(Register const a, Register const b) { return _mm_unpacklo_ps(a, b); }
+					static Register unpackhi(Register const a, Register const b) { return _mm_unpackhi_ps(a, b); }
+
+					/**
+					 * Loads 4 consecutive groups of 4 floats, group i is placed in r[i]
+					 */
+					static void load4(float const* data, Register r[4])
+					{
+						for (int i = 0; i < 4; i++)
+							r[i] = _mm_loadu_ps(data + 4 * i);
+					}
+
+					static void store4(float* data, Register const r[4])
+					{
+						for (int i = 0; i < 4; i++)
+							_mm_storeu_ps(data + 4 * i, r[i]);
+					}
+
+					/**
+					 * Stores the 4 floats of a single group. stride is the distance in floats to the next group (unused with 4 wide registers).
+					 */
+					static void storeGroup(float* data, size_t const /*stride*/, Register const r)
+					{
+						_mm_storeu_ps(data, r);
+					}
+
+					/**
+					 * Loads 4 consecutive vec3s as 3 registers (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3)
+					 */
+					static void load3(float const* data, Register r[3])
+					{
+						for (int i = 0; i < 3; i++)
+							r[i] = _mm_loadu_ps(data + 4 * i);
+					}
+
+					static void store3(float* data, Register const r[3])
+					{
+						for (int i = 0; i < 3; i++)
+							_mm_storeu_ps(data + 4 * i, r[i]);
+					}
+				};
+#endif
+
+#if defined(TRISTEON_SIMD_AVX2)
+				/**
+				 * 8 floats per register. Element i of a group lives in the lower lane, element i + 4 in the upper lane.
+				 */
+				struct Avx
+				{
+					typedef __m256 Register;
+					static size_t const width = 8;
+
+					static Register set1(float const value) { return _mm256_set1_ps(value); }
+					static Register add(Register const a, Register const b) { return _mm256_add_ps(a, b); }
+					static Register sub(Register const a, Register const b) { return _mm256_sub_ps(a, b); }
+					static Register mul(Register const a, Register const b) { return _mm256_mul_ps(a, b); }
+#if defined(__FMA__)
+					static Register madd(Register const a, Register const b, Register const c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+					static Register madd(Register const a, Register const b, Register const c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif
+					template <int Mask> static Register shuffle(Register const a, Register const b) { return _mm256_shuffle_ps(a, b, Mask); }
+					static Register unpacklo(Register const a, Register const b) { return _mm256_unpacklo_ps(a, b); }
+					static Register unpackhi(Register const a, Register const b) { return _mm256_unpackhi_ps(a, b); }
+
+					static Register combine(float const* low, float const* high)
+					{
+						return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+					}
+
+					static void split(float* low, float* high, Register const r)
+					{
+						_mm_storeu_ps(low, _mm256_castps256_ps128(r));
+						_mm_storeu_ps(high, _mm256_extractf128_ps(r, 1));
+					}
+
+					static void load4(float const* data, Register r[4])
+					{
+						for (int i = 0; i < 4; i++)
+							r[i] = combine(data + 4 * i, data + 16 + 4 * i);
+					}
+
+					static void store4(float* data, Register const r[4])
+					{
+						for (int i = 0; i < 4; i++)
+							split(data + 4 * i, data + 16 + 4 * i, r[i]);
+					}
+
+					static void storeGroup(float* data, size_t const stride, Register const r)
+					{
+						split(data, data + stride, r);
+					}
+
+					static void load3(float const* data, Register r[3])
+					{
+						for (int i = 0; i < 3; i++)
+							r[i] = combine(data + 4 * i, data + 12 + 4 * i);
+					}
+
+					static void store3(float* data, Register const r[3])
+					{
+						for (int i = 0; i < 3; i++)
+							split(data + 4 * i, data + 12 + 4 * i, r[i]);
+					}
+				};
+				typedef Avx Wide;
+#elif defined(TRISTEON_SIMD_SSE2)
+				typedef Sse Wide;
+#endif
+
+#if defined(TRISTEON_SIMD_SSE2)
+				/**
+				 * Converts 4 vec3s (as loaded by load3) into separate x, y and z registers
+				 */
+				template <typename S>
+				void deinterleave3(typename S::Register const in[3], typename S::Register& x, typename S::Register& y, typename S::Register& z)
+				{
+					typename S::Register const xy = S::template shuffle<_MM_SHUFFLE(2, 1, 3, 2)>(in[1], in[2]); //x2 y2 x3 y3
+					typename S::Register const yz = S::template shuffle<_MM_SHUFFLE(1, 0, 2, 1)>(in[0], in[1]); //y0 z0 y1 z1
+					x = S::template shuffle<_MM_SHUFFLE(2, 0, 3, 0)>(in[0], xy);
+					y = S::template shuffle<_MM_SHUFFLE(3, 1, 2, 0)>(yz, xy);
+					z = S::template shuffle<_MM_SHUFFLE(3, 0, 3, 1)>(yz, in[2]);
+				}
+
+				/**
+				 * The inverse of deinterleave3
+				 */
+				template <typename S>
+				void interleave3(typename S::Register const x, typename S::Register const y, typename S::Register const z, typename S::Register out[3])
+				{
+					typename S::Register const low = S::unpacklo(x, y); //x0 y0 x1 y1
+					typename S::Register const high = S::unpackhi(x, y); //x2 y2 x3 y3
+					out[0] = S::template shuffle<_MM_SHUFFLE(2, 0, 1, 0)>(low, S::template shuffle<_MM_SHUFFLE(2, 2, 0, 0)>(z, low));
+					out[1] = S::template shuffle<_MM_SHUFFLE(1, 0, 2, 0)>(S::template shuffle<_MM_SHUFFLE(1, 1, 3, 3)>(low, z), high);
+					out[2] = S::template shuffle<_MM_SHUFFLE(2, 0, 2, 0)>(S::template shuffle<_MM_SHUFFLE(2, 2, 2, 2)>(z, high), S::template shuffle<_MM_SHUFFLE(3, 3, 3, 3)>(high, z));
+				}
+
+				/**
+				 * Transposes 4x4 floats (per 128 bit lane)
+				 */
+				template <typename S>
+				void transpose4(typename S::Register r[4])
+				{
+					typename S::Register const t0 = S::unpacklo(r[0], r[1]);
+					typename S::Register const t1 = S::unpacklo(r[2], r[3]);
+					typename S::Register const t2 = S::unpackhi(r[0], r[1]);
+					typename S::Register const t3 = S::unpackhi(r[2], r[3]);
+					r[0] = S::template shuffle<_MM_SHUFFLE(1, 0, 1, 0)>(t0, t1);
+					r[1] = S::template shuffle<_MM_SHUFFLE(3, 2, 3, 2)>(t0, t1);
+					r[2] = S::template shuffle<_MM_SHUFFLE(1, 0, 1, 0)>(t2, t3);
+					r[3] = S::template shuffle<_MM_SHUFFLE(3, 2, 3, 2)>(t2, t3);
+				}
+
+				/**
+				 * Transforms S::width vec3s by the given matrix. Translation is only applied to points.
+				 */
+				template <typename S, bool Point>
+				void transformBlock(glm::mat4 const& m, glm::vec3 const* in, glm::vec3* out)
+				{
+					typename S::Register r[3];
+					S::load3(&in[0].x, r);
+
+					typename S::Register x, y, z;
+					deinterleave3<S>(r, x, y, z);
+
+					typename S::Register result[3];
+					for (int row = 0; row < 3; row++)
+					{
+						typename S::Register value = Point ? S::set1(m[3][row]) : S::set1(0.0f);
+						value = S::madd(S::set1(m[0][row]), x, value);
+						value = S::madd(S::set1(m[1][row]), y, value);
+						value = S::madd(S::set1(m[2][row]), z, value);
+						result[row] = value;
+					}
+
+					interleave3<S>(result[0], result[1], result[2], r);
+					S::store3(&out[0].x, r);
+				}
+
+				/**
+				 * Composes S::width TRS matrices. Positions and scales are optional.
+				 */
+				template <typename S>
+				void composeBlock(glm::vec3 const* positions, glm::quat const* rotations, glm::vec3 const* scales, glm::mat4* out)
+				{
+					typename S::Register q[4];
+					S::load4(&rotations[0].x, q);
+					transpose4<S>(q);
+					typename S::Register const x = q[0], y = q[1], z = q[2], w = q[3];
+
+					typename S::Register const one = S::set1(1.0f);
+					typename S::Register const two = S::set1(2.0f);
+					typename S::Register const zero = S::set1(0.0f);
+
+					typename S::Register const xx = S::mul(x, x), yy = S::mul(y, y), zz = S::mul(z, z);
+					typename S::Register const xy = S::mul(x, y), xz = S::mul(x, z), yz = S::mul(y, z);
+					typename S::Register const wx = S::mul(w, x), wy = S::mul(w, y), wz = S::mul(w, z);
+
+					//columns[c][r] is element r of column c, for every matrix in the block
+					typename S::Register columns[4][4];
+					columns[0][0] = S::sub(one, S::mul(two, S::add(yy, zz)));
+					columns[0][1] = S::mul(two, S::add(xy, wz));
+					columns[0][2] = S::mul(two, S::sub(xz, wy));
+					columns[1][0] = S::mul(two, S::sub(xy, wz));
+					columns[1][1] = S::sub(one, S::mul(two, S::add(xx, zz)));
+					columns[1][2] = S::mul(two, S::add(yz, wx));
+					columns[2][0] = S::mul(two, S::add(xz, wy));
+					columns[2][1] = S::mul(two, S::sub(yz, wx));
+					columns[2][2] = S::sub(one, S::mul(two, S::add(xx, yy)));
+					columns[0][3] = columns[1][3] = columns[2][3] = zero;
+					columns[3][0] = columns[3][1] = columns[3][2] = zero;
+					columns[3][3] = one;
+
+					typename S::Register r[3];
+					if (scales != nullptr)
+					{
+						typename S::Register scale[3];
+						S::load3(&scales[0].x, r);
+						deinterleave3<S>(r, scale[0], scale[1], scale[2]);
+						for (int c = 0; c < 3; c++)
+						{
+							for (int row = 0; row < 3; row++)
+								columns[c][row] = S::mul(columns[c][row], scale[c]);
+						}
+					}
+
+					if (positions != nullptr)
+					{
+						S::load3(&positions[0].x, r);
+						deinterleave3<S>(r, columns[3][0], columns[3][1], columns[3][2]);
+					}
+
+					//Back to one column per register
+					for (int c = 0; c < 4; c++)
+						transpose4<S>(columns[c]);
+
+					for (int c = 0; c < 4; c++)
+					{
+						for (int k = 0; k < 4; k++)
+							S::storeGroup(&out[k][c].x, 16 * 4, columns[c][k]);
+					}
+				}
+
+				/**
+				 * out = a * b, every column of out is a linear combination of the columns of a
+				 */
+				void multiply(glm::mat4 const& a, glm::mat4 const& b, glm::mat4& out)
+				{
+#if defined(TRISTEON_SIMD_AVX2)
+					__m256 const a0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&a[0].x));
+					__m256 const a1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&a[1].x));
+					__m256 const a2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&a[2].x));
+					__m256 const a3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&a[3].x));
+
+					//Two columns of b per register
+					__m256 result[2];
+					for (int i = 0; i < 2; i++)
+					{
+						__m256 const column = _mm256_loadu_ps(&b[i * 2].x);
+						__m256 value = Avx::mul(a0, _mm256_shuffle_ps(column, column, 0x00));
+						value = Avx::madd(a1, _mm256_shuffle_ps(column, column, 0x55), value);
+						value = Avx::madd(a2, _mm256_shuffle_ps(column, column, 0xAA), value);
+						result[i] = Avx::madd(a3, _mm256_shuffle_ps(column, column, 0xFF), value);
+					}
+
+					_mm256_storeu_ps(&out[0].x, result[0]);
+					_mm256_storeu_ps(&out[2].x, result[1]);
+#else
+					__m128 const a0 = _mm_loadu_ps(&a[0].x);
+					__m128 const a1 = _mm_loadu_ps(&a[1].x);
+					__m128 const a2 = _mm_loadu_ps(&a[2].x);
+					__m128 const a3 = _mm_loadu_ps(&a[3].x);
+
+					__m128 result[4];
+					for (int i = 0; i < 4; i++)
+					{
+						__m128 const column = _mm_loadu_ps(&b[i].x);
+						__m128 value = _mm_mul_ps(a0, _mm_shuffle_ps(column, column, 0x00));
+						value = _mm_add_ps(value, _mm_mul_ps(a1, _mm_shuffle_ps(column, column, 0x55)));
+						value = _mm_add_ps(value, _mm_mul_ps(a2, _mm_shuffle_ps(column, column, 0xAA)));
+						result[i] = _mm_add_ps(value, _mm_mul_ps(a3, _mm_shuffle_ps(column, column, 0xFF)));
+					}
+
+					for (int i = 0; i < 4; i++)
+						_mm_storeu_ps(&out[i].x, result[i]);
+#endif
+				}
+
+				/**
+				 * Runs transformBlock over every full block, and over a zero padded copy of the remainder
+				 */
+				template <bool Point>
+				void transformVectors(glm::mat4 const& m, glm::vec3 const* in, glm::vec3* out, size_t const count)
+				{
+					size_t i = 0;
+					for (; i + Wide::width <= count; i += Wide::width)
+						transformBlock<Wide, Point>(m, in + i, out + i);
+
+					if (i == count)
+						return;
+
+					glm::vec3 padded[Wide::width] = {};
+					std::copy(in + i, in + count, padded);
+					transformBlock<Wide, Point>(m, padded, padded);
+					std::copy(padded, padded + (count - i), out + i);
+				}
+
+				/**
+				 * Runs composeBlock over every full block, and over a padded copy of the remainder
+				 */
+				void compose(glm::vec3 const* positions, glm::quat const* rotations, glm::vec3 const* scales, glm::mat4* out, size_t const count)
+				{
+					size_t i = 0;
+					for (; i + Wide::width <= count; i += Wide::width)
+						composeBlock<Wide>(positions != nullptr ? positions + i : nullptr, rotations + i, scales != nullptr ? scales + i : nullptr, out + i);
+
+					if (i == count)
+						return;
+
+					size_t const remainder = count - i;
+					glm::vec3 paddedPositions[Wide::width] = {};
+					glm::quat paddedRotations[Wide::width];
+					glm::vec3 paddedScales[Wide::width] = {};
+					glm::mat4 paddedOut[Wide::width];
+					if (positions != nullptr)
+						std::copy(positions + i, positions + count, paddedPositions);
+					std::copy(rotations + i, rotations + count, paddedRotations);
+					if (scales != nullptr)
+						std::copy(scales + i, scales + count, paddedScales);
+
+					composeBlock<Wide>(positions != nullptr ? paddedPositions : nullptr, paddedRotations, scales != nullptr ? paddedScales : nullptr, paddedOut);
+					std::copy(paddedOut, paddedOut + remainder, out + i);
+				}
+#else
+				void multiply(glm::mat4 const& a, glm::mat4 const& b, glm::mat4& out)
+				{
+					out = a * b;
+				}
+
+				template <bool Point>
+				void transformVectors(glm::mat4 const& m, glm::vec3 const* in, glm::vec3* out, size_t const count)
+				{
+					for (size_t i = 0; i < count; i++)
+						out[i] = glm::vec3(m * glm::vec4(in[i], Point ? 1.0f : 0.0f));
+				}
+
+				void compose(glm::vec3 const* positions, glm::quat const* rotations, glm::vec3 const* scales, glm::mat4* out, size_t const count)
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						glm::mat4 result = glm::mat4_cast(rotations[i]);
+						if (scales != nullptr)
+						{
+							for (int c = 0; c < 3; c++)
+								result[c] *= scales[i][c];
+						}
+						if (positions != nullptr)
+							result[3] = glm::vec4(positions[i], 1.0f);
+						out[i] = result;
+					}
+				}
+#endif
+			}
+
+			char const* getInstructionSet()
+			{
+#if defined(TRISTEON_SIMD_AVX2)
+				return "AVX2";
+#elif defined(TRISTEON_SIMD_SSE2)
+				return "SSE2";
+#else
+				return "Scalar";
+#endif
+			}
+
+			void multiplyMatrices(glm::mat4 const* a, glm::mat4 const* b, glm::mat4* out, size_t const count)
+			{
+				for (size_t i = 0; i < count; i++)
+					multiply(a[i], b[i], out[i]);
+			}
+
+			void multiplyMatrices(glm::mat4 const& matrix, glm::mat4 const* a, glm::mat4* out, size_t const count)
+			{
+				//Copy in case matrix is an element of out
+				glm::mat4 const left = matrix;
+				for (size_t i = 0; i < count; i++)
+					multiply(left, a[i], out[i]);
+			}
+
+			void transformPoints(glm::mat4 const& matrix, glm::vec3 const* points, glm::vec3* out, size_t const count)
+			{
+				transformVectors<true>(matrix, points, out, count);
+			}
+
+			void transformDirections(glm::mat4 const& matrix, glm::vec3 const* directions, glm::vec3* out, size_t const count)
+			{
+				transformVectors<false>(matrix, directions, out, count);
+			}
+
+			void quaternionsToMatrices(glm::quat const* rotations, glm::mat4* out, size_t const count)
+			{
+				compose(nullptr, rotations, nullptr, out, count);
+			}
+
+			void composeTransforms(glm::vec3 const* positions, glm::quat const* rotations, glm::vec3 const* scales, glm::mat4* out, size_t const count)
+			{
+				compose(positions, rotations, scales, out, count);
+			}
+		}
+	}
+}
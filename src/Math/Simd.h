@@ -0,0 +1,65 @@
+﻿#pragma once
+#include <cstddef>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+//The instruction set used by the kernels is chosen at compile time. AVX2 is opt-in through the TRISTEON_AVX2 CMake option.
+#if defined(__AVX2__)
+#define TRISTEON_SIMD_AVX2
+#define TRISTEON_SIMD_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRISTEON_SIMD_SSE2
+#endif
+
+namespace Tristeon
+{
+	namespace Math
+	{
+		/**
+		 * Simd implements batched math kernels with SSE2 or AVX2, with a scalar fallback on other platforms.
+		 * Every kernel processes count elements at once, and produces the same results as the equivalent glm code.
+		 *
+		 * The kernels work on glm types. Vector3 and Quaternion have the same layout as glm::vec3 and glm::quat,
+		 * so arrays of those can be passed in directly through a reinterpret_cast.
+		 * Input and output arrays don't have to be aligned. Output arrays may not overlap with input arrays, unless stated otherwise.
+		 */
+		namespace Simd
+		{
+			/**
+			 * Returns the name of the instruction set the kernels were compiled with: "AVX2", "SSE2" or "Scalar"
+			 */
+			char const* getInstructionSet();
+
+			/**
+			 * out[i] = a[i] * b[i]. out may be the same array as a or b.
+			 */
+			void multiplyMatrices(glm::mat4 const* a, glm::mat4 const* b, glm::mat4* out, size_t count);
+
+			/**
+			 * out[i] = matrix * a[i]. out may be the same array as a.
+			 */
+			void multiplyMatrices(glm::mat4 const& matrix, glm::mat4 const* a, glm::mat4* out, size_t count);
+
+			/**
+			 * out[i] = matrix * vec4(points[i], 1). out may be the same array as points.
+			 */
+			void transformPoints(glm::mat4 const& matrix, glm::vec3 const* points, glm::vec3* out, size_t count);
+
+			/**
+			 * out[i] = matrix * vec4(directions[i], 0). out may be the same array as directions.
+			 */
+			void transformDirections(glm::mat4 const& matrix, glm::vec3 const* directions, glm::vec3* out, size_t count);
+
+			/**
+			 * out[i] = mat4_cast(rotations[i]). The rotations are expected to be normalized.
+			 */
+			void quaternionsToMatrices(glm::quat const* rotations, glm::mat4* out, size_t count);
+
+			/**
+			 * out[i] = translate(positions[i]) * mat4_cast(rotations[i]) * scale(scales[i]). The rotations are expected to be normalized.
+			 */
+			void composeTransforms(glm::vec3 const* positions, glm::quat const* rotations, glm::vec3 const* scales, glm::mat4* out, size_t count);
+		}
+	}
+}
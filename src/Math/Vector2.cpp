@@ -6,8 +6,6 @@ namespace Tristeon
 {
 	namespace Math
 	{
-		REGISTER_TYPE_CPP(Vector2)
-
 		Vector2::Vector2(float xy) : x(xy), y(xy) {}
 
 		Vector2::Vector2(float x, float y) : x(x), y(y) {}
@@ -164,19 +162,18 @@ namespace Tristeon
 			return "{ " + std::to_string(x) + ", " + std::to_string(y) + " }";
 		}
 
-		nlohmann::json Vector2::serialize()
+		void to_json(nlohmann::json& j, const Vector2& p)
 		{
-			nlohmann::json j;
+			j = nlohmann::json();
 			j["typeID"] = TRISTEON_TYPENAME(Vector2);
-			j["x"] = x;
-			j["y"] = y;
-			return j;
+			j["x"] = p.x;
+			j["y"] = p.y;
 		}
 
-		void Vector2::deserialize(nlohmann::json json)
+		void from_json(const nlohmann::json& j, Vector2& p)
 		{
-			x = json["x"];
-			y = json["y"];
+			p.x = j["x"];
+			p.y = j["y"];
 		}
 	}
 }
@@ -1,19 +1,18 @@
 ﻿#pragma once
 #include <string>
-#include "Core/TObject.h"
-#include "Editor/TypeRegister.h"
+#include <type_traits>
+#include <glm/vec2.hpp>
+#include "Editor/json.hpp"
 
 namespace Tristeon
 {
 	namespace Math
 	{
-		#define Vec_Convert2(vec) { vec.x, vec.y }
-		#define Vec_Ptr_Convert2(vec) { vec->x, vec->y}
-
 		/**
 		 * Vector2 interface, describes a 2D point or movement
+		 * Vector2 is a plain value type with the same layout as glm::vec2, and converts to and from glm::vec2 implicitly.
 		 */
-		struct Vector2 : Core::TObject
+		struct Vector2
 		{
 			/**
 			 * Creates a (xy, xy) Vector2
@@ -26,6 +25,15 @@ namespace Tristeon
 			 * \param y The y of this vector
 			 */
 			Vector2(float x = 0, float y = 0);
+			/**
+			 * Creates a Vector2 from the given glm vector
+			 */
+			Vector2(glm::vec2 const& vec) : x(vec.x), y(vec.y) { }
+
+			/**
+			 * Converts the vector to a glm vector
+			 */
+			operator glm::vec2() const { return { x, y }; }
 
 #pragma region quick vectors
 
@@ -133,11 +141,15 @@ namespace Tristeon
 			* Convert this instance to a string describing the properties
 			*/
 			std::string toString() const;
-
-			nlohmann::json serialize() override;
-			void deserialize(nlohmann::json json) override;
-		private:
-			REGISTER_TYPE_H(Vector2)
 		};
+
+		static_assert(std::is_trivially_copyable<Vector2>::value && std::is_standard_layout<Vector2>::value, "Vector2 must be a plain value type!");
+		static_assert(sizeof(Vector2) == sizeof(glm::vec2), "Vector2 must have the same layout as glm::vec2!");
+
+		/**
+		 * Json serialization of Vector2, also used by nlohmann::json for maps/vectors of Vector2
+		 */
+		void to_json(nlohmann::json& j, const Vector2& p);
+		void from_json(const nlohmann::json& j, Vector2& p);
 	}
 }
\ No newline at end of file
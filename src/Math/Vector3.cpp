@@ -7,8 +7,6 @@ namespace Tristeon
 {
 	namespace Math
 	{
-		REGISTER_TYPE_CPP(Vector3)
-
 		Vector3::Vector3(float xyz) : x(xyz), y(xyz), z(xyz) {}
 
 		Vector3::Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
@@ -184,26 +182,20 @@ namespace Tristeon
 			return "{ " + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + " }";
 		}
 
-		nlohmann::json Vector3::serialize()
+		void to_json(nlohmann::json& j, const Vector3& p)
 		{
-			return serialize_const();
-		}
-
-		nlohmann::json Vector3::serialize_const() const
-		{
-			nlohmann::json output;
-			output["typeID"] = TRISTEON_TYPENAME(Vector3);
-			output["x"] = x;
-			output["y"] = y;
-			output["z"] = z;
-			return output;
+			j = nlohmann::json();
+			j["typeID"] = TRISTEON_TYPENAME(Vector3);
+			j["x"] = p.x;
+			j["y"] = p.y;
+			j["z"] = p.z;
 		}
 
-		void Vector3::deserialize(nlohmann::json json)
+		void from_json(const nlohmann::json& j, Vector3& p)
 		{
-			x = json["x"];
-			y = json["y"];
-			z = json["z"];
+			p.x = j["x"];
+			p.y = j["y"];
+			p.z = j["z"];
 		}
 
 		Vector3 operator*(const float& multiplier, Vector3 vector)
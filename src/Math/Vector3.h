@@ -1,18 +1,19 @@
 #pragma once
-#include "Core/TObject.h"
-#include <Editor/TypeRegister.h>
+#include <array>
+#include <string>
+#include <type_traits>
+#include <glm/vec3.hpp>
+#include "Editor/json.hpp"
 
 namespace Tristeon
 {
 	namespace Math
 	{
-		#define Vec_Convert3(vec) { vec.x, vec.y, vec.z }
-		#define Vec_Ptr_Convert3(vec) { vec->x, vec->y, vec->z }
-
 		/**
 		* Vector3 interface, describes a 3D point or movement and implements math operations to modify said point/movement.
+		* Vector3 is a plain value type with the same layout as glm::vec3, and converts to and from glm::vec3 implicitly.
 		*/
-		struct Vector3 final : public Core::TObject
+		struct Vector3 final
 		{
 		public:
 			/**
@@ -24,6 +25,15 @@ namespace Tristeon
 			 * Creates a (x, y, z) Vector3
 			 */
 			Vector3(float x = 0, float y = 0, float z = 0);
+			/**
+			 * Creates a Vector3 from the given glm vector
+			 */
+			Vector3(glm::vec3 const& vec) : x(vec.x), y(vec.y), z(vec.z) { }
+
+			/**
+			 * Converts the vector to a glm vector
+			 */
+			operator glm::vec3() const { return { x, y, z }; }
 
 			#pragma region const static vectors
 			/**
@@ -132,29 +142,22 @@ namespace Tristeon
 			 * Convert this instance to a string describing the properties
 			 */
 			std::string toString() const;
-			
-			nlohmann::json serialize() override;
-			nlohmann::json serialize_const() const;
-			void deserialize(nlohmann::json json) override;
 
 			std::array<float, 3> toArray() const { return { x, y, z }; }
-
-		private:
-			REGISTER_TYPE_H(Vector3)
 		};
 
+		static_assert(std::is_trivially_copyable<Vector3>::value && std::is_standard_layout<Vector3>::value, "Vector3 must be a plain value type!");
+		static_assert(sizeof(Vector3) == sizeof(glm::vec3), "Vector3 must have the same layout as glm::vec3!");
+
 		/**
 		* Multiplies the x,y,z components with the given multiplier
 		*/
 		Vector3 operator*(const float& multiplier, Vector3 vector);
 
-		//Override functions for json maps/vectors
-		inline void to_json(nlohmann::json& j, const Vector3& p) {
-			j = p.serialize_const();
-		}
-
-		inline void from_json(const nlohmann::json& j, Vector3& p) {
-			p.deserialize(j);
-		}
+		/**
+		 * Json serialization of Vector3, also used by nlohmann::json for maps/vectors of Vector3
+		 */
+		void to_json(nlohmann::json& j, const Vector3& p);
+		void from_json(const nlohmann::json& j, Vector3& p);
 	}
 }
\ No newline at end of file
@@ -6,30 +6,23 @@ namespace Tristeon
 	namespace Misc
 	{
 		Color::Color(float r, float g, float b, float a) : r(r), g(g), b(b), a(a) { }
-		Color::Color(const Color& c) : r(c.r), g(c.g), b(c.b), a(c.a) { }
 
-		nlohmann::json Color::serialize()
+		void to_json(nlohmann::json& j, const Color& p)
 		{
-			return serialize_const();
-		}
-
-		nlohmann::json Color::serialize_const() const
-		{
-			nlohmann::json j;
+			j = nlohmann::json();
 			j["typeID"] = TRISTEON_TYPENAME(Color);
-			j["r"] = r;
-			j["g"] = g;
-			j["b"] = b;
-			j["a"] = a;
-			return j;
+			j["r"] = p.r;
+			j["g"] = p.g;
+			j["b"] = p.b;
+			j["a"] = p.a;
 		}
 
-		void Color::deserialize(nlohmann::json json)
+		void from_json(const nlohmann::json& j, Color& p)
 		{
-			r = json["r"];
-			g = json["g"];
-			b = json["b"];
-			a = json["a"];
+			p.r = j["r"];
+			p.g = j["g"];
+			p.b = j["b"];
+			p.a = j["a"];
 		}
 	}
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 ﻿#pragma once
-#include "Core/TObject.h"
+#include <array>
+#include <string>
+#include <type_traits>
+#include <glm/vec4.hpp>
+#include "Editor/json.hpp"
 
 namespace Tristeon
 {
@@ -7,11 +11,20 @@ namespace Tristeon
 	{
 		/**
 		 * Color is a structure used to describe a color by using 4 float values (rgba)
+		 * Color is a plain value type with the same layout as glm::vec4.
 		 */
-		struct Color final : Core::TObject
+		struct Color final
 		{
 			explicit Color(float r = 1, float g = 1, float b = 1, float a = 1);
-			Color(const Color& c);
+			/**
+			 * Creates a color from the given glm vector (xyzw = rgba)
+			 */
+			explicit Color(glm::vec4 const& vec) : r(vec.x), g(vec.y), b(vec.z), a(vec.w) { }
+
+			/**
+			 * Converts the color to a glm vector (rgba = xyzw)
+			 */
+			operator glm::vec4() const { return { r, g, b, a }; }
 
 			/**
 			 * Converts the color data to an array of 4 floats
@@ -24,19 +37,15 @@ namespace Tristeon
 			float g;
 			float b;
 			float a;
-
-			nlohmann::json serialize() override; 
-			nlohmann::json serialize_const() const;
-			void deserialize(nlohmann::json json) override;
 		};
 
-		//Override functions for json maps/vectors
-		inline void to_json(nlohmann::json& j, const Color& p) {
-			j = p.serialize_const();
-		}
+		static_assert(std::is_trivially_copyable<Color>::value && std::is_standard_layout<Color>::value, "Color must be a plain value type!");
+		static_assert(sizeof(Color) == sizeof(glm::vec4), "Color must have the same layout as glm::vec4!");
 
-		inline void from_json(const nlohmann::json& j, Color& p) {
-			p.deserialize(j);
-		}
+		/**
+		 * Json serialization of Color, also used by nlohmann::json for maps/vectors of Color
+		 */
+		void to_json(nlohmann::json& j, const Color& p);
+		void from_json(const nlohmann::json& j, Color& p);
 	}
 }
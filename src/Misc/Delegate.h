@@ -1,15 +1,35 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <functional>
-#include <algorithm> //Required in GNU GCC
 
 namespace Tristeon
 {
 	namespace Misc
 	{
 		/**
-		* Delegate is a callback class that wraps around a vector containing functions. 
+		 * Subscription is the token that is returned when a function is added to a Delegate, and it's used to remove said function again.
+		 * Tokens are generational, removing a function twice or using the token of a cleared delegate is ignored.
+		 */
+		struct Subscription
+		{
+			uint32_t id = UINT32_MAX;
+			uint32_t generation = 0;
+
+			/**
+			 * Returns false if the token was default constructed, true if it was returned by a delegate
+			 */
+			bool isValid() const { return id != UINT32_MAX; }
+		};
+
+		/**
+		* Delegate is a callback class that wraps around a vector containing functions.
 		* You can add or remove functions from this list, or call invoke() to call all subscribed functions.
+		*
+		* Functions are called in the order they were added. Removing a function is O(1), the slot is marked as removed and the
+		* slots are compacted at the start of the next invoke. Functions that are added while the delegate is being invoked
+		* are called from the next invoke onwards, functions that are removed while it's being invoked aren't called anymore.
 		*/
 		template <typename ... P>
 		class Delegate
@@ -23,19 +43,19 @@ namespace Tristeon
 			/**
 			* Calls all the functions added to this delegate.
 			*/
-			void operator()(std::function<void(P...)> f);
+			void operator()(P... params);
 
 			/**
 			 * Adds a function to the delegate. The function must have the same template as the Delegate.
+			 * \return The token that can be used to remove the function again. Empty functions aren't added and return an invalid token.
 			 */
-			void operator+=(std::function<void(P...)> f);
+			Subscription operator+=(std::function<void(P...)> f);
 
 			/**
-			 * Removes the given function from the delegate.
-			 * The function must have the same parameters as the delegate.
-			 * If this delegate doesn't contain the given function this will be ignored.
+			 * Removes the function that belongs to the given token from the delegate.
+			 * If this delegate doesn't contain the function anymore this will be ignored.
 			 */
-			void operator-=(std::function<void(P...)> f);
+			void operator-=(Subscription subscription);
 
 			/**
 			 * Resets the delegate and assigns it to the specific given function.
@@ -47,49 +67,209 @@ namespace Tristeon
 			 */
 			void clear();
 
+			/**
+			 * Returns true if the function that belongs to the given token is still part of the delegate
+			 */
+			bool contains(Subscription subscription) const;
+
+			/**
+			 * Returns the amount of functions in the delegate
+			 */
+			size_t size() const { return count; }
+
 		private:
-			std::vector<std::function<void(P...)>> events;
+			struct Slot
+			{
+				std::function<void(P...)> function;
+				uint32_t id;
+				bool removed;
+			};
+
+			/**
+			 * Moves the remaining slots to the front and appends the slots that were added while invoking
+			 */
+			void compact();
+			/**
+			 * Marks the slot as removed and returns its id to the free list
+			 */
+			void remove(Slot& slot);
+
+			/**
+			 * Set in locations for slots that are stored in pending rather than in slots
+			 */
+			static const uint32_t pendingBit = 0x80000000u;
+			/**
+			 * The location of ids that aren't in use
+			 */
+			static const uint32_t freeLocation = UINT32_MAX;
+
+			/**
+			 * The functions in the order they were added, including the removed ones that haven't been compacted yet
+			 */
+			std::vector<Slot> slots;
+			/**
+			 * Functions that were added while invoking, they're moved into slots during the next compaction
+			 */
+			std::vector<Slot> pending;
+			/**
+			 * Per id, the index of its slot. Only valid while the generation of the id matches.
+			 */
+			std::vector<uint32_t> locations;
+			std::vector<uint32_t> generations;
+			std::vector<uint32_t> freeIds;
+
+			size_t count = 0;
+			/**
+			 * The amount of invoke calls that are currently running, slots isn't modified while this isn't 0
+			 */
+			uint32_t invoking = 0;
+			/**
+			 * True if slots contains removed slots or if pending isn't empty
+			 */
+			bool fragmented = false;
 		};
 
 		template <typename ... P>
 		void Delegate<P...>::invoke(P... params)
 		{
-			for (unsigned int i = 0; i < events.size(); i++)
-				events[i](params...);
+			if (invoking == 0 && fragmented)
+				compact();
+
+			invoking++;
+			//slots doesn't grow while invoking, removed slots are skipped but kept alive because they might be executing
+			for (size_t i = 0; i < slots.size(); i++)
+			{
+				if (!slots[i].removed)
+					slots[i].function(params...);
+			}
+			invoking--;
 		}
 
 		template <typename ... P>
-		void Delegate<P...>::operator()(std::function<void(P...)> f)
+		void Delegate<P...>::operator()(P... params)
 		{
-			this->invoke(f);
+			this->invoke(params...);
 		}
 
 		template <typename ... P>
-		void Delegate<P...>::operator+=(std::function<void(P...)> f)
+		Subscription Delegate<P...>::operator+=(std::function<void(P...)> f)
 		{
-			events.push_back(f);
+			if (!f)
+				return Subscription();
+
+			uint32_t id;
+			if (!freeIds.empty())
+			{
+				id = freeIds.back();
+				freeIds.pop_back();
+			}
+			else
+			{
+				id = uint32_t(generations.size());
+				generations.push_back(0);
+				locations.push_back(0);
+			}
+
+			Slot slot = { std::move(f), id, false };
+			if (invoking > 0)
+			{
+				locations[id] = pendingBit | uint32_t(pending.size());
+				pending.push_back(std::move(slot));
+				fragmented = true;
+			}
+			else
+			{
+				locations[id] = uint32_t(slots.size());
+				slots.push_back(std::move(slot));
+			}
+
+			count++;
+			Subscription subscription;
+			subscription.id = id;
+			subscription.generation = generations[id];
+			return subscription;
 		}
 
 		template <typename ... P>
-		void Delegate<P...>::operator-=(std::function<void(P...)> f)
+		void Delegate<P...>::operator-=(Subscription subscription)
 		{
-			//Try to find the given function
-			auto itr = std::find(events.begin(), events.end(), events);
-			if (itr != std::end(events))
-				events.erase(itr);
+			if (!contains(subscription))
+				return;
+
+			uint32_t const location = locations[subscription.id];
+			if (location & pendingBit)
+				remove(pending[location & ~pendingBit]);
+			else
+				remove(slots[location]);
 		}
 
 		template <typename ... P>
 		void Delegate<P...>::operator=(std::function<void(P...)> f)
 		{
-			events.clear();
-			events.push_back(f);
+			clear();
+			*this += std::move(f);
 		}
 
 		template <typename ... P>
 		void Delegate<P...>::clear()
 		{
-			events.clear();
+			for (Slot& slot : slots)
+			{
+				if (!slot.removed)
+					remove(slot);
+			}
+			for (Slot& slot : pending)
+			{
+				if (!slot.removed)
+					remove(slot);
+			}
+		}
+
+		template <typename ... P>
+		bool Delegate<P...>::contains(Subscription subscription) const
+		{
+			return subscription.id < generations.size() && generations[subscription.id] == subscription.generation && locations[subscription.id] != freeLocation;
+		}
+
+		template <typename ... P>
+		void Delegate<P...>::compact()
+		{
+			size_t remaining = 0;
+			for (size_t i = 0; i < slots.size(); i++)
+			{
+				if (slots[i].removed)
+					continue;
+				if (remaining != i)
+					slots[remaining] = std::move(slots[i]);
+				locations[slots[remaining].id] = uint32_t(remaining);
+				remaining++;
+			}
+			slots.erase(slots.begin() + remaining, slots.end());
+
+			for (Slot& slot : pending)
+			{
+				if (slot.removed)
+					continue;
+				locations[slot.id] = uint32_t(slots.size());
+				slots.push_back(std::move(slot));
+			}
+			pending.clear();
+			fragmented = false;
+		}
+
+		template <typename ... P>
+		void Delegate<P...>::remove(Slot& slot)
+		{
+			slot.removed = true;
+			//The function might be the one that's calling us, only release it when we're sure it isn't executing
+			if (invoking == 0)
+				slot.function = nullptr;
+
+			generations[slot.id]++;
+			locations[slot.id] = freeLocation;
+			freeIds.push_back(slot.id);
+			count--;
+			fragmented = true;
 		}
 	}
 }
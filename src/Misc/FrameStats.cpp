@@ -0,0 +1,111 @@
+﻿#include "FrameStats.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		std::array<FrameStats::Frame, FrameStats::capacity> FrameStats::frames;
+		uint64_t FrameStats::recorded = 0;
+		uint64_t FrameStats::hitches = 0;
+		float FrameStats::hitchThreshold = 1000.0f / 30.0f;
+		std::array<std::atomic<int64_t>, FP_COUNT> FrameStats::current;
+
+		/**
+		 * The column names of the phases in the csv, in the order of FramePhase
+		 */
+		static const char* const phaseNames[] = { "fixedupdate", "update", "prerender", "render", "present" };
+		static_assert(sizeof(phaseNames) / sizeof(phaseNames[0]) == FP_COUNT, "Every frame phase needs a name");
+
+		static float toMilliseconds(std::chrono::steady_clock::duration duration)
+		{
+			return std::chrono::duration<float, std::milli>(duration).count();
+		}
+
+		FrameStatistics FrameStats::getStatistics()
+		{
+			return calculate(-1);
+		}
+
+		FrameStatistics FrameStats::getStatistics(FramePhase phase)
+		{
+			return calculate(int(phase));
+		}
+
+		size_t FrameStats::getFrameCount()
+		{
+			return recorded < capacity ? size_t(recorded) : capacity;
+		}
+
+		bool FrameStats::writeCSV(std::string const& filePath)
+		{
+			std::ofstream stream(filePath);
+			if (!stream.is_open())
+				return false;
+
+			stream << "frame,total";
+			for (const char* name : phaseNames)
+				stream << ',' << name;
+			stream << '\n';
+
+			size_t const count = getFrameCount();
+			for (uint64_t i = recorded - count; i < recorded; i++)
+			{
+				Frame const& frame = frames[i % capacity];
+				stream << i << ',' << frame.total;
+				for (float phase : frame.phases)
+					stream << ',' << phase;
+				stream << '\n';
+			}
+			return stream.good();
+		}
+
+		void FrameStats::addPhaseTime(FramePhase phase, std::chrono::steady_clock::duration duration)
+		{
+			current[phase].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), std::memory_order_relaxed);
+		}
+
+		void FrameStats::endFrame(std::chrono::steady_clock::duration duration)
+		{
+			Frame& frame = frames[recorded % capacity];
+			frame.total = toMilliseconds(duration);
+			for (size_t i = 0; i < FP_COUNT; i++)
+				frame.phases[i] = toMilliseconds(std::chrono::nanoseconds(current[i].exchange(0, std::memory_order_relaxed)));
+
+			if (frame.total > hitchThreshold)
+				hitches++;
+			recorded++;
+		}
+
+		FrameStatistics FrameStats::calculate(int phase)
+		{
+			FrameStatistics statistics;
+			size_t const count = getFrameCount();
+			if (count == 0)
+				return statistics;
+
+			std::vector<float> values(count);
+			for (size_t i = 0; i < count; i++)
+				values[i] = phase < 0 ? frames[i].total : frames[i].phases[phase];
+			std::sort(values.begin(), values.end());
+
+			//Nearest-rank percentiles
+			auto const percentile = [&](float p) { return values[std::min(count - 1, size_t(std::ceil(p / 100.0f * count)) - 1)]; };
+
+			float sum = 0;
+			for (float value : values)
+				sum += value;
+
+			statistics.min = values.front();
+			statistics.max = values.back();
+			statistics.average = sum / count;
+			statistics.p50 = percentile(50);
+			statistics.p95 = percentile(95);
+			statistics.p99 = percentile(99);
+			return statistics;
+		}
+	}
+}
\ No newline at end of file
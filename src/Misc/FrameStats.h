@@ -0,0 +1,147 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		class Engine;
+	}
+
+	namespace Misc
+	{
+		/**
+		 * The parts of a frame that FrameStats keeps track of
+		 */
+		enum FramePhase
+		{
+			FP_FIXEDUPDATE,
+			FP_UPDATE,
+			FP_PRERENDER,
+			FP_RENDER,
+			/**
+			 * Presenting the swapchain image. With the RENDERTHREAD user pref this happens on the render thread,
+			 * and it's added to the frame during which the present finished. Without it, it's part of FP_RENDER as well.
+			 */
+			FP_PRESENT,
+
+			/**
+			 * The amount of phases. Not a phase, new phases must be added above this.
+			 */
+			FP_COUNT
+		};
+
+		/**
+		 * Summarizes the durations of the recorded frames, in milliseconds
+		 */
+		struct FrameStatistics
+		{
+			float min = 0;
+			float max = 0;
+			float average = 0;
+			float p50 = 0;
+			float p95 = 0;
+			float p99 = 0;
+		};
+
+		/**
+		 * FrameStats records the duration of every frame and of its phases in a ring buffer that holds the last FrameStats::capacity frames.
+		 * Statistics are calculated over the frames in the buffer. Frames that take longer than the FRAMEHITCHTHRESHOLD user pref (in milliseconds)
+		 * are counted as hitches, the hitch count covers every frame since the engine started.
+		 *
+		 * If the FRAMESTATSOUTPUT user pref is set, the frames in the buffer are written to said file as csv when the engine closes.
+		 */
+		class FrameStats final
+		{
+			friend Core::Engine;
+		public:
+			/**
+			 * The amount of frames that is kept
+			 */
+			static const size_t capacity = 1024;
+
+			/**
+			 * Returns the statistics of the total frame time
+			 */
+			static FrameStatistics getStatistics();
+			/**
+			 * Returns the statistics of the given phase
+			 */
+			static FrameStatistics getStatistics(FramePhase phase);
+			/**
+			 * Returns the amount of frames that the statistics are calculated over
+			 */
+			static size_t getFrameCount();
+			/**
+			 * Returns the amount of frames since the engine started that took longer than the hitch threshold
+			 */
+			static uint64_t getHitchCount() { return hitches; }
+			/**
+			 * Returns the frame time in milliseconds above which a frame counts as a hitch
+			 */
+			static float getHitchThreshold() { return hitchThreshold; }
+
+			/**
+			 * Writes the recorded frames to the given file as csv, from oldest to newest. Durations are in milliseconds.
+			 * \return False if the file couldn't be written
+			 */
+			static bool writeCSV(std::string const& filePath);
+
+			/**
+			 * Adds the given duration to the given phase of the current frame. Can be called from any thread.
+			 */
+			static void addPhaseTime(FramePhase phase, std::chrono::steady_clock::duration duration);
+
+		private:
+			struct Frame
+			{
+				float total;
+				std::array<float, FP_COUNT> phases;
+			};
+
+			/**
+			 * Stores the frame with the given duration and the phase times that were added since the previous frame
+			 */
+			static void endFrame(std::chrono::steady_clock::duration duration);
+			/**
+			 * Calculates the statistics of the given member of the recorded frames, -1 being the total frame time
+			 */
+			static FrameStatistics calculate(int phase);
+
+			static std::array<Frame, capacity> frames;
+			/**
+			 * The amount of frames that has been recorded in total, the next frame is stored at recorded % capacity
+			 */
+			static uint64_t recorded;
+			static uint64_t hitches;
+			static float hitchThreshold;
+			/**
+			 * The phase times of the current frame in nanoseconds
+			 */
+			static std::array<std::atomic<int64_t>, FP_COUNT> current;
+
+			FrameStats() = delete;
+			~FrameStats() = delete;
+		};
+
+		/**
+		 * FramePhaseTimer adds the time between its construction and its destruction to the given phase of the current frame
+		 */
+		class FramePhaseTimer final
+		{
+		public:
+			explicit FramePhaseTimer(FramePhase phase) : phase(phase), start(std::chrono::steady_clock::now()) { }
+			~FramePhaseTimer() { FrameStats::addPhaseTime(phase, std::chrono::steady_clock::now() - start); }
+
+			FramePhaseTimer(FramePhaseTimer const&) = delete;
+			FramePhaseTimer& operator=(FramePhaseTimer const&) = delete;
+		private:
+			FramePhase phase;
+			std::chrono::steady_clock::time_point start;
+		};
+	}
+}
\ No newline at end of file
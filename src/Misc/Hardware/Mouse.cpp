@@ -77,6 +77,10 @@ namespace Tristeon
 			if (image.getWidth() <= 0 || image.getHeight() <= 0)
 				throw std::invalid_argument("Invalid image passed to Mouse::setCursorImage!");
 
+			//There's no cursor when running headless
+			if (window == nullptr)
+				return;
+
 			GLFWimage i;
 			i.width = image.getWidth();
 			i.height = image.getHeight();
@@ -89,11 +93,15 @@ namespace Tristeon
 
 		void Mouse::setCursorDefault(CursorShape shape)
 		{
+			if (window == nullptr)
+				return;
 			glfwSetCursor(window, glfwCreateStandardCursor(shape));
 		}
 
 		void Mouse::setCursorMode(CursorMode mode)
 		{
+			if (window == nullptr)
+				return;
 			glfwSetInputMode(window, GLFW_CURSOR, mode);
 		}
 
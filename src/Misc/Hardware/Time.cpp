@@ -7,6 +7,8 @@ namespace Tristeon
 		std::chrono::time_point<std::chrono::high_resolution_clock> Time::start = std::chrono::high_resolution_clock::now();
 		float Time::deltaTime = 0;
 		float Time::fps = 60;
+		float Time::fixedDeltaTime = 1.0f / 50.0f;
+		float Time::interpolationAlpha = 0;
 
 		float Time::getTimeSinceStart()
 		{
@@ -25,5 +27,15 @@ namespace Tristeon
 		{
 			return fps;
 		}
+
+		float Time::getFixedDeltaTime()
+		{
+			return fixedDeltaTime;
+		}
+
+		float Time::getInterpolationAlpha()
+		{
+			return interpolationAlpha;
+		}
 	}
 }
@@ -32,11 +32,22 @@ namespace Tristeon
 			 * Gets the current amount of frames per second
 			 */
 			static float getFPS();
+			/**
+			 * Gets the time in seconds between two fixed updates, this is configured through the FIXEDDELTATIME user pref
+			 */
+			static float getFixedDeltaTime();
+			/**
+			 * Gets how far the current frame is between the last fixed update and the next one, in the range [0, 1).
+			 * Renderers can use this to blend the state of the previous fixed update with the current one.
+			 */
+			static float getInterpolationAlpha();
 
 		private:
 			static std::chrono::time_point<std::chrono::high_resolution_clock> start;
 			static float deltaTime;
 			static float fps;
+			static float fixedDeltaTime;
+			static float interpolationAlpha;
 		};
 	}
 }
\ No newline at end of file
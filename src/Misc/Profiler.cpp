@@ -0,0 +1,160 @@
+﻿#include "Profiler.h"
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		namespace
+		{
+			struct Zone
+			{
+				const char* name;
+				int64_t begin;
+				int64_t end;
+			};
+
+			/**
+			 * The zones recorded by a single thread. Only the owning thread modifies the zones, endCapture() waits for it to finish writing before reading them.
+			 */
+			struct ThreadBuffer
+			{
+				std::vector<Zone> zones;
+				/**
+				 * The capture that the zones belong to. Zones of older captures are discarded lazily by the owning thread.
+				 */
+				uint32_t generation = 0;
+				/**
+				 * Set while the owning thread might be modifying the zones
+				 */
+				std::atomic<bool> writing{ false };
+				uint32_t id = 0;
+				std::string name;
+			};
+
+			/**
+			 * Every buffer that has ever been created. Buffers aren't destroyed when their thread exits, so that their zones can still be exported.
+			 * The mutex also guards the buffer names and the capture start.
+			 */
+			std::mutex buffersMutex;
+			std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+			int64_t captureStart = 0;
+
+			thread_local ThreadBuffer* threadBuffer = nullptr;
+
+			ThreadBuffer* getThreadBuffer()
+			{
+				if (threadBuffer == nullptr)
+				{
+					std::lock_guard<std::mutex> lock(buffersMutex);
+					buffers.push_back(std::make_unique<ThreadBuffer>());
+					threadBuffer = buffers.back().get();
+					threadBuffer->id = uint32_t(buffers.size());
+					threadBuffer->name = "Thread " + std::to_string(threadBuffer->id);
+				}
+				return threadBuffer;
+			}
+
+			void writeString(std::ostream& stream, const char* string)
+			{
+				stream << '"';
+				for (const char* c = string; *c != '\0'; c++)
+				{
+					if (*c == '"' || *c == '\\')
+						stream << '\\';
+					stream << *c;
+				}
+				stream << '"';
+			}
+		}
+
+		std::atomic<bool> Profiler::capturing(false);
+		std::atomic<uint32_t> Profiler::generation(0);
+
+		void Profiler::beginCapture()
+		{
+			//The buffers aren't touched here, their owning threads discard the zones of the previous capture once they see the new generation
+			std::lock_guard<std::mutex> lock(buffersMutex);
+			captureStart = now();
+			generation.fetch_add(1);
+			capturing = true;
+		}
+
+		bool Profiler::endCapture(std::string const& filePath)
+		{
+			std::lock_guard<std::mutex> lock(buffersMutex);
+			capturing = false;
+
+			//Threads that started recording before capturing was cleared have to finish first. Threads that start later see that capturing is false and leave their buffer alone.
+			uint32_t const current = generation.load();
+			for (std::unique_ptr<ThreadBuffer>& buffer : buffers)
+			{
+				while (buffer->writing.load())
+					std::this_thread::yield();
+			}
+
+			std::ofstream stream(filePath);
+			if (!stream.is_open())
+				return false;
+
+			stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+			bool first = true;
+
+			for (std::unique_ptr<ThreadBuffer>& buffer : buffers)
+			{
+				//Metadata event so that the thread shows up with its name
+				stream << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+				writeString(stream, buffer->name.c_str());
+				stream << "}}";
+				first = false;
+
+				//Complete events, timestamps are in microseconds relative to the start of the capture
+				if (buffer->generation == current)
+				{
+					for (Zone const& zone : buffer->zones)
+					{
+						stream << ",\n{\"name\":";
+						writeString(stream, zone.name);
+						stream << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->id << ",\"ts\":" << (zone.begin - captureStart) / 1000.0 << ",\"dur\":" << (zone.end - zone.begin) / 1000.0 << "}";
+					}
+				}
+				buffer->zones.clear();
+			}
+
+			stream << "\n]}";
+			return stream.good();
+		}
+
+		void Profiler::setThreadName(std::string const& name)
+		{
+			ThreadBuffer* buffer = getThreadBuffer();
+			std::lock_guard<std::mutex> lock(buffersMutex);
+			buffer->name = name;
+		}
+
+		void Profiler::record(const char* name, uint32_t const zoneGeneration, int64_t begin, int64_t end)
+		{
+			ThreadBuffer* buffer = getThreadBuffer();
+
+			//Announce the write before checking capturing, endCapture() clears capturing before checking writing. Both are sequentially consistent,
+			//so either endCapture() waits for this write to finish or this thread sees that the capture has ended.
+			buffer->writing.store(true);
+			//Zones that were opened before the current capture began are dropped
+			if (capturing.load() && zoneGeneration == generation.load(std::memory_order_relaxed))
+			{
+				if (buffer->generation != zoneGeneration)
+				{
+					buffer->zones.clear();
+					buffer->generation = zoneGeneration;
+				}
+				buffer->zones.push_back({ name, begin, end });
+			}
+			buffer->writing.store(false, std::memory_order_release);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+﻿#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		class ProfileZone;
+
+		/**
+		 * Profiler records named zones of CPU time, which can be exported as Chrome trace events (chrome://tracing or https://ui.perfetto.dev).
+		 * Every thread records into its own buffer without taking any locks, only beginCapture() and endCapture() synchronize with the recording threads.
+		 * Zones are only recorded between beginCapture() and endCapture(), outside of a capture a zone costs a single atomic load.
+		 * Zones that were opened before the capture began or that are still open when it ends are dropped.
+		 *
+		 * Zones are added with TRISTEON_PROFILE_SCOPE(name) and TRISTEON_PROFILE_FUNCTION(). These compile to nothing unless TRISTEON_PROFILER is defined,
+		 * which is done by the TRISTEON_PROFILER CMake option.
+		 */
+		class Profiler final
+		{
+			friend ProfileZone;
+		public:
+			/**
+			 * Discards the previous capture and starts recording zones
+			 */
+			static void beginCapture();
+			/**
+			 * Stops recording zones and writes the capture to the given file as Chrome trace event json
+			 * \return False if the file couldn't be written
+			 */
+			static bool endCapture(std::string const& filePath);
+			/**
+			 * Returns true if zones are currently being recorded
+			 */
+			static bool isCapturing() { return capturing.load(std::memory_order_relaxed); }
+
+			/**
+			 * Sets the name that the calling thread is shown with in exported captures
+			 */
+			static void setThreadName(std::string const& name);
+
+		private:
+			/**
+			 * Adds a zone to the buffer of the calling thread, if the capture it was opened in is still running
+			 */
+			static void record(const char* name, uint32_t generation, int64_t begin, int64_t end);
+			/**
+			 * The current time in nanoseconds
+			 */
+			static int64_t now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+			static std::atomic<bool> capturing;
+			/**
+			 * Incremented by every beginCapture(), zones remember the capture they were opened in
+			 */
+			static std::atomic<uint32_t> generation;
+
+			Profiler() = delete;
+			~Profiler() = delete;
+		};
+
+		/**
+		 * ProfileZone records the time between its construction and its destruction.
+		 * The name isn't copied, it has to stay valid until the capture has been exported (e.g. a string literal).
+		 */
+		class ProfileZone final
+		{
+		public:
+			explicit ProfileZone(const char* name) : name(Profiler::isCapturing() ? name : nullptr),
+				generation(this->name != nullptr ? Profiler::generation.load(std::memory_order_relaxed) : 0),
+				begin(this->name != nullptr ? Profiler::now() : 0) { }
+			~ProfileZone()
+			{
+				if (name != nullptr)
+					Profiler::record(name, generation, begin, Profiler::now());
+			}
+
+			ProfileZone(ProfileZone const&) = delete;
+			ProfileZone& operator=(ProfileZone const&) = delete;
+		private:
+			const char* name;
+			uint32_t generation;
+			int64_t begin;
+		};
+	}
+}
+
+#ifdef TRISTEON_PROFILER
+#define TRISTEON_PROFILE_CONCAT_IMPL(a, b) a##b
+#define TRISTEON_PROFILE_CONCAT(a, b) TRISTEON_PROFILE_CONCAT_IMPL(a, b)
+/**
+ * Records the time until the end of the current scope as a zone with the given name
+ */
+#define TRISTEON_PROFILE_SCOPE(name) ::Tristeon::Misc::ProfileZone TRISTEON_PROFILE_CONCAT(profileZone, __LINE__)(name)
+/**
+ * Records the time until the end of the current scope as a zone named after the current function
+ */
+#define TRISTEON_PROFILE_FUNCTION() TRISTEON_PROFILE_SCOPE(__FUNCTION__)
+/**
+ * Sets the name that the calling thread is shown with in exported captures
+ */
+#define TRISTEON_PROFILE_THREAD(name) ::Tristeon::Misc::Profiler::setThreadName(name)
+#else
+#define TRISTEON_PROFILE_SCOPE(name)
+#define TRISTEON_PROFILE_FUNCTION()
+#define TRISTEON_PROFILE_THREAD(name)
+#endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 ﻿#include "StringUtils.h"
 #include <iterator>
+#include <random>
 #include <vector>
 #include "Console.h"
 
@@ -19,11 +20,15 @@ std::string StringUtils::generateRandom(int length)
 		"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
 		"abcdefghijklmnopqrstuvwxyz";
 	static const int size = sizeof(alphanum);
+
+	//rand() shares its state between threads, every thread gets its own engine instead
+	thread_local std::mt19937 engine(std::random_device{}());
+	std::uniform_int_distribution<int> distribution(0, size - 2);
 	
 	std::string output;
 
 	for (int i = 0; i < length; ++i) {
-		output.push_back(alphanum[rand() % (size - 1)]);
+		output.push_back(alphanum[distribution(engine)]);
 	}
 
 	return output;
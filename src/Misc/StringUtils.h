@@ -15,6 +15,7 @@ public:
 
 	/**
 	 * Generates a string with random characters with a given length.
+	 * Safe to call from multiple threads.
 	 * 
 	 * \exception invalid_argument if length <= 0
 	 */
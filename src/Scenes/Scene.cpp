@@ -37,7 +37,7 @@ namespace Tristeon
 				{
 					std::unique_ptr<Core::GameObject> gameObject = std::make_unique<Core::GameObject>();
 					gameObject->deserialize(iterator->get<nlohmann::json>());
-					gameObjects.push_back(std::move(gameObject));
+					insertGameObject(std::move(gameObject));
 				}
 			} else
 			{
@@ -50,25 +50,120 @@ namespace Tristeon
 		void Scene::addGameObject(std::unique_ptr<Core::GameObject> gameObj)
 		{
 			gameObj->deserialize(gameObj->serialize());
+			insertGameObject(std::move(gameObj));
+		}
+
+		void Scene::insertGameObject(std::unique_ptr<Core::GameObject> gameObj)
+		{
+			addToArchetype(gameObj.get());
+			instanceIDs[gameObj->getInstanceID()] = gameObj->getHandle();
+			gameObj->sceneIndex = gameObjects.size();
 			gameObjects.push_back(std::move(gameObj));
 		}
 
 		void Scene::removeGameObject(Core::GameObject* gameObj)
 		{
-			for (int i = 0; i < gameObjects.size(); ++i)
+			if (gameObj == nullptr || gameObj->scene != this)
+				return;
+
+			removeFromArchetype(gameObj);
+
+			auto const lookup = instanceIDs.find(gameObj->getInstanceID());
+			if (lookup != instanceIDs.end() && lookup->second == gameObj->getHandle())
+				instanceIDs.erase(lookup);
+
+			//Swap and pop, the last gameobject takes the index of the removed one
+			size_t const index = gameObj->sceneIndex;
+			if (index != gameObjects.size() - 1)
 			{
-				if (gameObjects[i].get() == gameObj) { gameObjects.erase(gameObjects.begin() + i); }
+				std::swap(gameObjects[index], gameObjects.back());
+				gameObjects[index]->sceneIndex = index;
 			}
+			gameObjects.pop_back();
 		}
 
-		Core::GameObject* Scene::getGameObject(std::string instanceID)
+		Core::GameObject* Scene::getGameObject(uint64_t instanceID)
 		{
-			for (int i = 0; i < gameObjects.size(); ++i)
+			auto const lookup = instanceIDs.find(instanceID);
+			if (lookup != instanceIDs.end())
 			{
-				if (gameObjects[i]->getInstanceID() == instanceID) return gameObjects[i].get();
+				Core::GameObject* gameObj = getGameObject(lookup->second);
+				if (gameObj != nullptr && gameObj->getInstanceID() == instanceID)
+					return gameObj;
+			}
+
+			//The lookup is outdated if the gameobject has been deserialized since it was added, fall back to a search
+			for (size_t i = 0; i < gameObjects.size(); ++i)
+			{
+				if (gameObjects[i]->getInstanceID() == instanceID)
+				{
+					instanceIDs[instanceID] = gameObjects[i]->getHandle();
+					return gameObjects[i].get();
+				}
 			}
 			std::cout << "Couldn't find gameObject\n";
 			return nullptr;
 		}
+
+		Core::GameObject* Scene::getGameObject(Core::Handle<Core::GameObject> handle)
+		{
+			Core::GameObject* gameObj = handle.get();
+			return gameObj != nullptr && gameObj->scene == this ? gameObj : nullptr;
+		}
+
+		void Scene::addToArchetype(Core::GameObject* gameObj)
+		{
+			uint64_t const mask = gameObj->componentMask;
+
+			auto iterator = archetypeIndices.find(mask);
+			if (iterator == archetypeIndices.end())
+			{
+				Archetype archetype;
+				archetype.mask = mask;
+				archetype.columns.resize(popcount64(mask));
+				archetypes.push_back(std::move(archetype));
+				iterator = archetypeIndices.emplace(mask, archetypes.size() - 1).first;
+			}
+
+			Archetype& archetype = archetypes[iterator->second];
+			gameObj->scene = this;
+			gameObj->archetypeIndex = iterator->second;
+			gameObj->archetypeRow = archetype.gameObjects.size();
+
+			archetype.gameObjects.push_back(gameObj);
+			//componentSlots is ordered by type ID, just like the columns
+			for (size_t i = 0; i < archetype.columns.size(); i++)
+				archetype.columns[i].push_back(gameObj->componentSlots[i]);
+		}
+
+		void Scene::removeFromArchetype(Core::GameObject* gameObj)
+		{
+			if (gameObj->scene != this)
+				return;
+
+			Archetype& archetype = archetypes[gameObj->archetypeIndex];
+			size_t const row = gameObj->archetypeRow;
+			size_t const last = archetype.gameObjects.size() - 1;
+
+			if (row != last)
+			{
+				archetype.gameObjects[row] = archetype.gameObjects[last];
+				archetype.gameObjects[row]->archetypeRow = row;
+				for (std::vector<Core::Components::Component*>& column : archetype.columns)
+					column[row] = column[last];
+			}
+
+			archetype.gameObjects.pop_back();
+			for (std::vector<Core::Components::Component*>& column : archetype.columns)
+				column.pop_back();
+
+			gameObj->scene = nullptr;
+		}
+
+		void Scene::updateArchetype(Core::GameObject* gameObj)
+		{
+			removeFromArchetype(gameObj);
+			addToArchetype(gameObj);
+		}
 	}
 }
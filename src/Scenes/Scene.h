@@ -2,7 +2,10 @@
 #include "Core/TObject.h"
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include "Core/GameObject.h"
+#include "SceneQuery.h"
+#include "SceneCommandBuffer.h"
 
 namespace Tristeon
 {
@@ -15,6 +18,7 @@ namespace Tristeon
 		class Scene final : public Core::TObject
 		{
 			friend SceneManager;
+			friend Core::GameObject;
 		public:
 			/**
 			 * Adds the GameObject to the scene and reserializes it to set its values back to their defaults.
@@ -27,21 +31,82 @@ namespace Tristeon
 			 * Removes the GameObject from the scene. 
 			 * The GameObject automatically gets destroyed. 
 			 * Any references to the GameObject will automatically turn invalid.
+			 * The last GameObject in the scene takes the place of the removed one.
+			 * Use getCommandBuffer() instead when removing GameObjects from within component callbacks.
 			 */
 			void removeGameObject(Core::GameObject* gameObj);
 
 			/**
-			 * Returns the first GameObject in the list with the given instanceID. 
+			 * Returns the command buffer of the scene.
+			 * GameObjects that are added or removed through the command buffer are applied in bulk at the end of the frame,
+			 * which makes it safe to spawn and destroy GameObjects during update.
+			 */
+			SceneCommandBuffer& getCommandBuffer() { return commandBuffer; }
+			/**
+			 * Applies the changes that were recorded in the command buffer. Called by SceneManager at the end of every frame.
+			 * Don't call this while components are iterating the scene, e.g. from within update.
+			 */
+			void applyCommandBuffer() { commandBuffer.apply(*this); }
+
+			/**
+			 * Returns the GameObject with the given instanceID. 
+			 * Will return nullptr if no GO is found.
+			 */
+			Core::GameObject* getGameObject(uint64_t instanceID);
+			/**
+			 * Returns the GameObject with the given serialized instanceID. 
 			 * Will return nullptr if no GO is found.
 			 */
-			Core::GameObject* getGameObject(std::string instanceID);
+			Core::GameObject* getGameObject(std::string const& instanceID) { return getGameObject(Core::TObject::instanceIDFromString(instanceID)); }
+
+			/**
+			 * Returns the GameObject the handle refers to, if it's still alive and part of this scene. Otherwise returns nullptr.
+			 */
+			Core::GameObject* getGameObject(Core::Handle<Core::GameObject> handle);
+
+			/**
+			 * Returns a view over every GameObject that has at least one component of each of the given types.
+			 * GameObjects are grouped by their set of component types, so the query only visits matching groups.
+			 */
+			template <typename... T>
+			SceneQuery<T...> query() const { return SceneQuery<T...>(archetypes); }
 
 			nlohmann::json serialize() override;
 			void deserialize(nlohmann::json json) override;
 		private:
 			void init();
 
+			/**
+			 * Adds the gameobject to the archetype that matches its current components
+			 */
+			void addToArchetype(Core::GameObject* gameObj);
+			/**
+			 * Removes the gameobject from its archetype by moving the last row into its place
+			 */
+			void removeFromArchetype(Core::GameObject* gameObj);
+			/**
+			 * Moves the gameobject to the archetype that matches its current components. Called by GameObject when its components change.
+			 */
+			void updateArchetype(Core::GameObject* gameObj);
+
+			/**
+			 * Adds the GameObject to the gameObjects list and its archetype
+			 */
+			void insertGameObject(std::unique_ptr<Core::GameObject> gameObj);
+
 			std::vector<std::unique_ptr<Tristeon::Core::GameObject>> gameObjects;
+			SceneCommandBuffer commandBuffer;
+
+			std::vector<Archetype> archetypes;
+			/**
+			 * Maps archetype masks to their index in archetypes
+			 */
+			std::unordered_map<uint64_t, size_t> archetypeIndices;
+
+			/**
+			 * Maps instanceIDs to gameobjects. Entries are checked on lookup, as the instanceID of a gameobject can change when it's deserialized.
+			 */
+			std::unordered_map<uint64_t, Core::Handle<Core::GameObject>> instanceIDs;
 			REGISTER_TYPE_H(Scene)
 		};
 	}
@@ -0,0 +1,39 @@
+﻿#include "SceneCommandBuffer.h"
+#include "Scene.h"
+
+namespace Tristeon
+{
+	namespace Scenes
+	{
+		void SceneCommandBuffer::addGameObject(std::unique_ptr<Core::GameObject> gameObj)
+		{
+			added.push_back(std::move(gameObj));
+		}
+
+		void SceneCommandBuffer::removeGameObject(Core::GameObject* gameObj)
+		{
+			if (gameObj != nullptr)
+				removed.push_back(gameObj->getHandle());
+		}
+
+		void SceneCommandBuffer::apply(Scene& scene)
+		{
+			//Swap the lists out first, so changes recorded while applying (e.g. by destructors) end up in the next frame
+			std::vector<std::unique_ptr<Core::GameObject>> addedNow;
+			std::vector<Core::Handle<Core::GameObject>> removedNow;
+			addedNow.swap(added);
+			removedNow.swap(removed);
+
+			for (std::unique_ptr<Core::GameObject>& gameObj : addedNow)
+				scene.addGameObject(std::move(gameObj));
+
+			//Handles are resolved one at a time, removing a gameobject might destroy others.
+			//Handles of destroyed gameobjects (including duplicates that were removed already) resolve to nullptr and are skipped.
+			for (Core::Handle<Core::GameObject> const handle : removedNow)
+			{
+				if (Core::GameObject* gameObj = handle.get())
+					scene.removeGameObject(gameObj);
+			}
+		}
+	}
+}
@@ -0,0 +1,50 @@
+﻿#pragma once
+#include <memory>
+#include <vector>
+#include "Core/Handle.h"
+
+namespace Tristeon
+{
+	namespace Core { class GameObject; }
+
+	namespace Scenes
+	{
+		class Scene;
+
+		/**
+		 * SceneCommandBuffer records structural changes to a scene (adding and removing GameObjects) and applies them in bulk.
+		 * Every scene owns a command buffer, which SceneManager applies at MT_AFTERFRAME.
+		 * Recording a change is cheap and doesn't touch the scene, so it's safe to use from within component callbacks.
+		 *
+		 * Added GameObjects are applied before removed ones, so a GameObject that is added and removed in the same frame is destroyed correctly.
+		 */
+		class SceneCommandBuffer final
+		{
+			friend Scene;
+		public:
+			/**
+			 * Records a GameObject to be added to the scene at the end of the frame. The buffer takes ownership of the GameObject.
+			 */
+			void addGameObject(std::unique_ptr<Core::GameObject> gameObj);
+			/**
+			 * Records a GameObject to be removed from the scene at the end of the frame.
+			 * The GameObject stays valid until then. Recording the same GameObject more than once is allowed.
+			 * The GameObject is referred to by handle, so it's simply skipped if it has already been destroyed by the time the buffer is applied.
+			 */
+			void removeGameObject(Core::GameObject* gameObj);
+
+			/**
+			 * Returns true if no changes have been recorded since the buffer was last applied
+			 */
+			bool empty() const { return added.empty() && removed.empty(); }
+		private:
+			/**
+			 * Applies all the recorded changes to the given scene and clears the buffer
+			 */
+			void apply(Scene& scene);
+
+			std::vector<std::unique_ptr<Core::GameObject>> added;
+			std::vector<Core::Handle<Core::GameObject>> removed;
+		};
+	}
+}
@@ -4,6 +4,7 @@
 #include "Scene.h"
 #include "Core/Rendering/Components/MeshRenderer.h"
 #include "Editor/JsonSerializer.h"
+#include "Misc/Profiler.h"
 
 namespace Tristeon
 {
@@ -17,6 +18,13 @@ namespace Tristeon
 			activeScene = std::make_unique<Scene>();
 			activeScene->name = "UnNamed";
 
+			//Structural changes that were recorded during the frame are applied once everything is done using the scene
+			afterFrame = Core::MessageBus::subscribeToMessage(Core::MT_AFTERFRAME, [](Core::Message)
+			{
+				if (activeScene != nullptr)
+					activeScene->applyCommandBuffer();
+			});
+
 			//Load scenes into the manager
 			std::ifstream stream("Scenes.ProjectSettings", std::fstream::in | std::fstream::out | std::fstream::app);
 			nlohmann::json json;
@@ -35,6 +43,12 @@ namespace Tristeon
 			}
 		}
 
+		SceneManager::~SceneManager()
+		{
+			Core::MessageBus::unsubscribeFromMessage(afterFrame);
+			activeScene.reset();
+		}
+
 		void SceneManager::loadScene(int id)
 		{
 			loadScene(sceneFilePaths.begin()->first);
@@ -42,6 +56,7 @@ namespace Tristeon
 
 		void SceneManager::loadScene(std::string name)
 		{
+			TRISTEON_PROFILE_SCOPE("SceneManager::loadScene");
 			Core::MessageBus::sendMessage(Core::MT_MANAGER_RESET);
 
 			//Attempt to deserialize scene from file
@@ -57,33 +72,35 @@ namespace Tristeon
 
 		void SceneManager::loadScene(Scene* scene)
 		{
+			TRISTEON_PROFILE_SCOPE("SceneManager::initScene");
 			Core::MessageBus::sendMessage(Core::MT_MANAGER_RESET);
 			scene->init();
 			activeScene = std::unique_ptr<Scene>(scene);
 			createParentalBonds(activeScene.get());
 		}
 
-		Core::Transform* SceneManager::findTransformByInstanceID(std::string instanceID)
+		void SceneManager::createParentalBonds(Scene* scene)
 		{
-			for (int i = 0; i < activeScene->gameObjects.size(); ++i)
+			std::vector<std::unique_ptr<Core::GameObject>>& gameObjects = scene->gameObjects;
+
+			//Index the transforms by instanceID once, so every parent lookup takes constant time
+			std::unordered_map<uint64_t, Core::Handle<Core::Transform>> transforms;
+			transforms.reserve(gameObjects.size());
+			for (size_t i = 0; i < gameObjects.size(); ++i)
 			{
-				if (activeScene->gameObjects[i]->transform.get()->getInstanceID() == instanceID)
-					return activeScene->gameObjects[i].get()->transform.get();
+				Core::Transform* transform = gameObjects[i]->transform.get();
+				transforms[transform->getInstanceID()] = transform->getHandle();
 			}
-			return nullptr;
-		}
 
-		void SceneManager::createParentalBonds(Scene* scene)
-		{
-			std::vector<std::unique_ptr<Core::GameObject>>& gameObjects = scene->gameObjects;
-			for (int i = 0; i < gameObjects.size(); ++i)
+			for (size_t i = 0; i < gameObjects.size(); ++i)
 			{
 				auto parent = gameObjects[i]->transform.get()->parentID;
 				//Does gameobject have a parent?
-				if (parent != "null")
+				if (parent != Core::TObject::invalidInstanceID)
 				{
 					//Find and set the parent
-					gameObjects[i]->transform.get()->setParent(findTransformByInstanceID(parent));
+					auto const lookup = transforms.find(parent);
+					gameObjects[i]->transform.get()->setParent(lookup != transforms.end() ? lookup->second.get() : nullptr);
 				}
 			}
 		}
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <string>
 #include "Scene.h"
+#include "Core/MessageBus.h"
 
 #ifdef TRISTEON_EDITOR
 #include "Editor/Asset Browser/SceneFileitem.h"
@@ -51,9 +52,11 @@ namespace Tristeon
 			static Scene* getActiveScene() { return activeScene.get(); }
 		private:
 			SceneManager();
-			~SceneManager() { activeScene.reset(); }
+			~SceneManager();
 
-			static Core::Transform* findTransformByInstanceID(std::string instanceID);
+			/**
+			 * Links every transform in the scene to the parent it was serialized with
+			 */
 			static void createParentalBonds(Scene* scene);
 
 			static void addScenePath(std::string name, std::string path);
@@ -61,6 +64,8 @@ namespace Tristeon
 
 			static std::map<std::string,std::string> sceneFilePaths;
 			static std::unique_ptr<Scene> activeScene;
+
+			Core::MessageBus::Subscription afterFrame;
 		};
 	}
 }
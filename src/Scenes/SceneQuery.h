@@ -0,0 +1,212 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Core/GameObject.h"
+
+namespace Tristeon
+{
+	namespace Scenes
+	{
+		/**
+		 * An archetype is a table of all the gameobjects in a scene that have the exact same set of component types.
+		 * Every component type in the set has its own column, ordered by type ID like GameObject::componentSlots.
+		 * Columns hold pointers, the components themselves stay wherever their ComponentManager pool allocated them.
+		 * Queries only visit the archetypes that match, and walk their columns linearly without any per-object type lookups.
+		 */
+		struct Archetype
+		{
+			/**
+			 * The component type IDs (as bits) of the gameobjects in this archetype
+			 */
+			uint64_t mask = 0;
+			/**
+			 * The rows of the table
+			 */
+			std::vector<Core::GameObject*> gameObjects;
+			/**
+			 * A column per component type in mask. columns[column][row] points to the first component of said type on gameObjects[row]
+			 */
+			std::vector<std::vector<Core::Components::Component*>> columns;
+		};
+
+		/**
+		 * Describes how a query reads a single type T from an archetype. Component types are read from their column.
+		 */
+		template <typename T>
+		struct QueryColumn
+		{
+			static_assert(std::is_base_of<Core::Components::Component, T>::value, "Scene queries only support components and Transform!");
+			static_assert(!std::is_abstract<T>::value, "Scene queries require concrete component types!");
+
+			/**
+			 * Returns false if the type ID of T is too high to be stored in archetype masks
+			 */
+			static bool isRepresentable()
+			{
+				return Core::Components::ComponentTraits::getTypeID<T>() < Core::GameObject::maxLookupTypes;
+			}
+
+			/**
+			 * The archetype mask bit of T, 0 if T can't be represented in the mask
+			 */
+			static uint64_t getBit()
+			{
+				return isRepresentable() ? uint64_t(1) << Core::Components::ComponentTraits::getTypeID<T>() : 0;
+			}
+
+			static Core::Components::Component* const* getColumn(Archetype const& archetype)
+			{
+				return archetype.columns[popcount64(archetype.mask & (getBit() - 1))].data();
+			}
+
+			static T* get(Archetype const& /*archetype*/, Core::Components::Component* const* column, size_t row)
+			{
+				return static_cast<T*>(column[row]);
+			}
+		};
+
+		/**
+		 * Every gameobject has a Transform, it's read from the gameobject rather than from a column.
+		 */
+		template <>
+		struct QueryColumn<Core::Transform>
+		{
+			static bool isRepresentable() { return true; }
+			static uint64_t getBit() { return 0; }
+			static Core::Components::Component* const* getColumn(Archetype const& /*archetype*/) { return nullptr; }
+
+			static Core::Transform* get(Archetype const& archetype, Core::Components::Component* const* /*column*/, size_t row)
+			{
+				return archetype.gameObjects[row]->transform.get();
+			}
+		};
+
+		/**
+		 * SceneQuery is a view over all the gameobjects in a scene that have at least one component of every type in T.
+		 * Obtained through Scene::query<T...>(). The view is invalidated when gameobjects or components are added or removed.
+		 *
+		 * Usage:
+		 *		scene->query<Transform, MeshRenderer>().forEach([](GameObject* go, Transform* t, MeshRenderer* m) { ... });
+		 */
+		template <typename... T>
+		class SceneQuery
+		{
+		public:
+			explicit SceneQuery(std::vector<Archetype> const& archetypes) : archetypes(archetypes) { }
+
+			/**
+			 * Calls function(GameObject*, T*...) for every matching gameobject
+			 */
+			template <typename F>
+			void forEach(F function) const;
+
+			/**
+			 * Returns the amount of matching gameobjects
+			 */
+			size_t size() const;
+
+			/**
+			 * Returns true if the given archetype contains all the types of the query
+			 */
+			static bool matches(Archetype const& archetype)
+			{
+				uint64_t const required = getMask();
+				return (archetype.mask & required) == required;
+			}
+		private:
+			/**
+			 * Returns false if one of the types can't be represented in archetype masks, in which case the query falls back to getComponent
+			 */
+			static bool isRepresentable()
+			{
+				bool result = true;
+				for (bool const representable : std::initializer_list<bool>{ true, QueryColumn<T>::isRepresentable()... })
+					result = result && representable;
+				return result;
+			}
+
+			/**
+			 * Returns true if the gameobject has every type of the query. Only used by the fallback path.
+			 */
+			static bool hasAll(Core::GameObject* gameObject)
+			{
+				bool result = true;
+				for (bool const has : std::initializer_list<bool>{ true, (gameObject->getComponent<T>() != nullptr)... })
+					result = result && has;
+				return result;
+			}
+
+			static uint64_t getMask()
+			{
+				uint64_t mask = 0;
+				for (uint64_t const bit : std::initializer_list<uint64_t>{ 0, QueryColumn<T>::getBit()... })
+					mask |= bit;
+				return mask;
+			}
+
+			template <typename F, size_t... I>
+			static void forEach(Archetype const& archetype, F& function, std::index_sequence<I...>);
+
+			std::vector<Archetype> const& archetypes;
+		};
+
+		template <typename... T>
+		template <typename F>
+		void SceneQuery<T...>::forEach(F function) const
+		{
+			if (!isRepresentable())
+			{
+				//Every gameobject is in exactly one archetype, so the tables still cover the full scene
+				for (Archetype const& archetype : archetypes)
+				{
+					for (Core::GameObject* gameObject : archetype.gameObjects)
+					{
+						if (hasAll(gameObject))
+							function(gameObject, gameObject->getComponent<T>()...);
+					}
+				}
+				return;
+			}
+
+			for (Archetype const& archetype : archetypes)
+			{
+				if (matches(archetype))
+					forEach(archetype, function, std::index_sequence_for<T...>{});
+			}
+		}
+
+		template <typename... T>
+		template <typename F, size_t... I>
+		void SceneQuery<T...>::forEach(Archetype const& archetype, F& function, std::index_sequence<I...>)
+		{
+			//Look up the columns once per archetype, the inner loop only indexes the pointer arrays
+			std::array<Core::Components::Component* const*, sizeof...(T)> const columns = { { QueryColumn<T>::getColumn(archetype)... } };
+			(void)columns;
+
+			for (size_t row = 0; row < archetype.gameObjects.size(); row++)
+				function(archetype.gameObjects[row], QueryColumn<T>::get(archetype, columns[I], row)...);
+		}
+
+		template <typename... T>
+		size_t SceneQuery<T...>::size() const
+		{
+			size_t result = 0;
+			if (!isRepresentable())
+			{
+				forEach([&](Core::GameObject*, T*...) { result++; });
+				return result;
+			}
+
+			for (Archetype const& archetype : archetypes)
+			{
+				if (matches(archetype))
+					result += archetype.gameObjects.size();
+			}
+			return result;
+		}
+	}
+}
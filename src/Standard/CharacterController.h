@@ -11,6 +11,11 @@ namespace Tristeon
 			nlohmann::json serialize() override;
 			void deserialize(nlohmann::json json) override;
 			void update() override;
+
+			/**
+			 * Only moves its own transform, so controllers can be updated in parallel
+			 */
+			static const uint8_t componentAccess = Core::Components::CA_OWN_TRANSFORM;
 		private:
 			float speed = 10;
 		};
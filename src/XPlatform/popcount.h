@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+
+#if defined(_MSC_VER)
+
+/**
+ * Returns the amount of bits that are set in value.
+ * MSVC's __popcnt intrinsics emit the POPCNT instruction unconditionally, which faults on CPUs that don't support it.
+ * The bits are counted in parallel instead, which the optimizer keeps to a handful of instructions.
+ */
+inline unsigned int popcount64(uint64_t value)
+{
+	value = value - ((value >> 1) & 0x5555555555555555ull);
+	value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+	value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return unsigned((value * 0x0101010101010101ull) >> 56);
+}
+
+#else
+
+/**
+ * Wrapper around the compiler intrinsic, returns the amount of bits that are set in value.
+ * Without -mpopcnt the compiler falls back to a portable implementation, so this is safe on any CPU.
+ */
+inline unsigned int popcount64(uint64_t value)
+{
+	return unsigned(__builtin_popcountll(value));
+}
+#endif
@@ -0,0 +1,68 @@
+﻿/*
+ tristeon_tests runs the engine's tests and exits with a non-zero status if any of them fail.
+
+ USAGE
+ * tristeon_tests [--filter=NAME]
+ * Tests whose name doesn't contain the filter are skipped.
+*/
+
+#include "Test.h"
+#include <iostream>
+
+namespace
+{
+	int failures = 0;
+}
+
+namespace Tristeon
+{
+	namespace Test
+	{
+		std::vector<std::pair<std::string, TestFunction>>& getTests()
+		{
+			static std::vector<std::pair<std::string, TestFunction>> tests;
+			return tests;
+		}
+
+		void fail(const char* expression, const char* file, int line)
+		{
+			std::cerr << file << "(" << line << "): check failed: " << expression << std::endl;
+			failures++;
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string filter;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string const argument = argv[i];
+		if (argument.compare(0, 9, "--filter=") == 0)
+		{
+			filter = argument.substr(9);
+		}
+		else
+		{
+			std::cerr << "Unknown argument " << argument << std::endl;
+			return 1;
+		}
+	}
+
+	int failedTests = 0;
+	for (auto const& test : Tristeon::Test::getTests())
+	{
+		if (test.first.find(filter) == std::string::npos)
+			continue;
+
+		int const before = failures;
+		test.second();
+		bool const passed = failures == before;
+		if (!passed)
+			failedTests++;
+		std::cerr << (passed ? "[ PASSED ] " : "[ FAILED ] ") << test.first << std::endl;
+	}
+
+	std::cerr << failedTests << " test(s) failed" << std::endl;
+	return failedTests == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+﻿#include "Test.h"
+#include "Scenes/Scene.h"
+
+using namespace Tristeon;
+
+/**
+ * A queued removal of a gameobject that has been destroyed in the meantime is skipped,
+ * even if a gameobject that is added by the same buffer ends up at its address
+ */
+TRISTEON_TEST(removeDestroyedGameObject)
+{
+	Scenes::Scene scene;
+	std::unique_ptr<Core::GameObject> removed = std::make_unique<Core::GameObject>();
+	Core::GameObject* removedPtr = removed.get();
+	scene.addGameObject(std::move(removed));
+
+	scene.getCommandBuffer().removeGameObject(removedPtr);
+	scene.removeGameObject(removedPtr);
+
+	std::unique_ptr<Core::GameObject> added = std::make_unique<Core::GameObject>();
+	Core::Handle<Core::GameObject> const addedHandle = added->getHandle();
+	scene.getCommandBuffer().addGameObject(std::move(added));
+	scene.applyCommandBuffer();
+
+	TRISTEON_CHECK(scene.getCommandBuffer().empty());
+	TRISTEON_CHECK(scene.getGameObject(addedHandle) != nullptr);
+}
+
+/**
+ * Recording the same removal twice destroys the gameobject once
+ */
+TRISTEON_TEST(removeGameObjectTwice)
+{
+	Scenes::Scene scene;
+	std::unique_ptr<Core::GameObject> gameObj = std::make_unique<Core::GameObject>();
+	Core::GameObject* gameObjPtr = gameObj.get();
+	Core::Handle<Core::GameObject> const handle = gameObj->getHandle();
+	scene.addGameObject(std::move(gameObj));
+	std::unique_ptr<Core::GameObject> kept = std::make_unique<Core::GameObject>();
+	Core::Handle<Core::GameObject> const keptHandle = kept->getHandle();
+	scene.addGameObject(std::move(kept));
+
+	scene.getCommandBuffer().removeGameObject(gameObjPtr);
+	scene.getCommandBuffer().removeGameObject(gameObjPtr);
+	scene.applyCommandBuffer();
+
+	TRISTEON_CHECK(!handle);
+	TRISTEON_CHECK(scene.getGameObject(keptHandle) != nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+﻿#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Tristeon
+{
+	namespace Test
+	{
+		typedef void (*TestFunction)();
+
+		/**
+		 * Returns every test that has been registered with TRISTEON_TEST
+		 */
+		std::vector<std::pair<std::string, TestFunction>>& getTests();
+
+		/**
+		 * Records a failed check of the test that is currently running
+		 */
+		void fail(const char* expression, const char* file, int line);
+
+		/**
+		 * Registers a test function during static initialization
+		 */
+		struct Registrar
+		{
+			Registrar(const char* name, TestFunction function) { getTests().emplace_back(name, function); }
+		};
+	}
+}
+
+/**
+ * Defines and registers a test function
+ */
+#define TRISTEON_TEST(name) \
+	static void name(); \
+	static ::Tristeon::Test::Registrar name##Registrar(#name, &name); \
+	static void name()
+
+/**
+ * Fails the current test if the condition is false, the test keeps running
+ */
+#define TRISTEON_CHECK(condition) \
+	do { if (!(condition)) ::Tristeon::Test::fail(#condition, __FILE__, __LINE__); } while (false)